@@ -0,0 +1,120 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "AtomDispatcher.h"
+
+#include <climits>
+
+#include "Heuristic.h"
+#include "util/HeuristicUtil.h"
+#include "util/Options.h"
+#include "util/Trace.h"
+
+unsigned int
+Atom::getNumber(
+    unsigned int i ) const
+{
+    int number;
+    if( !HeuristicUtil::getNumber( getArgumentName( i ), number ) || number < 0 )
+        return 0;
+    return number;
+}
+
+unsigned int
+AtomDispatcher::subscribe(
+    Heuristic* heuristic,
+    const string& name,
+    unsigned int arity )
+{
+    vector< pair< unsigned int, unsigned int > >& arities = signatures[ name ];
+    for( unsigned int i = 0; i < arities.size(); i++ )
+    {
+        if( arities[ i ].first == arity )
+        {
+            subscribers[ arities[ i ].second ].push_back( heuristic );
+            return arities[ i ].second;
+        }
+    }
+
+    unsigned int signature = subscribers.size();
+    arities.push_back( make_pair( arity, signature ) );
+    subscribers.push_back( vector< Heuristic* >( 1, heuristic ) );
+
+    trace_msg( heuristic, 2, "Subscribed to " << name << "/" << arity << " ( signature " << signature << " )" );
+    return signature;
+}
+
+void
+AtomDispatcher::dispatch(
+    Var numberOfVariables )
+{
+    // the subscribed signatures, by id of their predicate
+    vector< const vector< pair< unsigned int, unsigned int > >* > byPredicate;
+    for( unordered_map< string, vector< pair< unsigned int, unsigned int > > >::const_iterator it = signatures.begin(); it != signatures.end(); ++it )
+    {
+        unsigned int predicate = VariableNames::findPredicate( it->first );
+        if( predicate == VariableNames::NONE )
+            continue;
+        if( predicate >= byPredicate.size() )
+            byPredicate.resize( predicate + 1, NULL );
+        byPredicate[ predicate ] = &it->second;
+    }
+
+    Atom atom;
+    for( Var variable = 1; variable <= numberOfVariables; variable++ )
+    {
+        if( VariableNames::isHidden( variable ) )
+            continue;
+
+        unsigned int predicate = VariableNames::getPredicate( variable );
+        if( predicate >= byPredicate.size() || byPredicate[ predicate ] == NULL )
+            continue;
+
+        // the arguments are read only for the subscribed predicates
+        unsigned int arity;
+        const unsigned int* arguments = VariableNames::getArguments( variable, arity );
+        if( arguments == NULL )
+            continue;
+
+        unsigned int signature = findSignature( *byPredicate[ predicate ], arity );
+        if( signature == UINT_MAX )
+            continue;
+
+        atom.variable = variable;
+        atom.signature = signature;
+        atom.arity = arity;
+        atom.arguments = arguments;
+
+        trace_msg( heuristic, 3, "Dispatching variable " << variable << " " << VariableNames::getName( variable ) << " ( signature " << signature << " )" );
+        for( Heuristic* heuristic : subscribers[ signature ] )
+            heuristic->onAtom( atom );
+    }
+}
+
+unsigned int
+AtomDispatcher::findSignature(
+    const vector< pair< unsigned int, unsigned int > >& arities,
+    unsigned int arity ) const
+{
+    for( unsigned int i = 0; i < arities.size(); i++ )
+    {
+        if( arities[ i ].first == arity )
+            return arities[ i ].second;
+    }
+    return UINT_MAX;
+}
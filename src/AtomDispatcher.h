@@ -0,0 +1,98 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef ATOMDISPATCHER_H
+#define ATOMDISPATCHER_H
+
+#include <cassert>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "util/Constants.h"
+#include "util/VariableNames.h"
+
+using namespace std;
+
+class Heuristic;
+
+/*
+ * An atom of the input, as passed to the heuristics subscribed to its signature.
+ * The arguments are interned by VariableNames: equal terms have the same id.
+ */
+class Atom
+{
+    friend class AtomDispatcher;
+
+    public:
+        inline Var getVariable() const { return variable; }
+        inline unsigned int getSignature() const { return signature; }
+        inline unsigned int getArity() const { return arity; }
+        inline unsigned int getArgument( unsigned int i ) const { assert( i < arity ); return arguments[ i ]; }
+        inline const string& getArgumentName( unsigned int i ) const { return VariableNames::getArgumentName( getArgument( i ) ); }
+
+        /**
+         * The argument as an unsigned number (0 if it is not a number, or it is negative).
+         */
+        unsigned int getNumber( unsigned int i ) const;
+
+    private:
+        inline Atom() : variable( 0 ), signature( 0 ), arity( 0 ), arguments( NULL ) {}
+
+        Var variable;
+        unsigned int signature;
+        unsigned int arity;
+        const unsigned int* arguments;
+};
+
+/*
+ * Routes the atoms of the input to the heuristics subscribed to their signature
+ * (predicate and arity). The visible variables are visited once, in a single
+ * pass, whatever the number of heuristics; their predicates are already interned
+ * by VariableNames, which tokenises the arguments (see TermTokenizer) only for
+ * the predicates some heuristic subscribed to.
+ */
+class AtomDispatcher
+{
+    public:
+        inline AtomDispatcher() {}
+
+        /**
+         * Subscribes the heuristic to the atoms with the given predicate and arity,
+         * and returns the id of the signature (the same for all its subscribers).
+         */
+        unsigned int subscribe( Heuristic* heuristic, const string& predicate, unsigned int arity );
+
+        inline bool hasSubscriptions() const { return !subscribers.empty(); }
+
+        /**
+         * Passes each visible variable among 1..numberOfVariables whose atom has a
+         * subscribed signature to the onAtom of its subscribers.
+         */
+        void dispatch( Var numberOfVariables );
+
+    private:
+        unsigned int findSignature( const vector< pair< unsigned int, unsigned int > >& arities, unsigned int arity ) const;
+
+        // per predicate: arity and id of its subscribed signatures
+        unordered_map< string, vector< pair< unsigned int, unsigned int > > > signatures;
+        vector< vector< Heuristic* > > subscribers;
+};
+
+#endif
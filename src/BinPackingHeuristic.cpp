@@ -19,197 +19,409 @@
 #include "BinPackingHeuristic.h"
 
 #include <algorithm>
+#include <climits>
 #include <iterator>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "AtomDispatcher.h"
+#include "HeuristicRegistry.h"
 #include "Solver.h"
 #include "util/Assert.h"
 #include "util/Constants.h"
-#include "util/VariableNames.h"
-#include "util/HeuristicUtil.h"
+
+REGISTER_HEURISTIC( "binpacking", BinPackingHeuristic );
 
 BinPackingHeuristic::BinPackingHeuristic(
-    Solver& s ) : Heuristic( s ), index( 0 ), numberOfBins( 0 ), maxBinSize( 0 ), numberOfConflicts( 0 ), isConsistent( true ), conflictOccured( false )
+    Solver& s ) : Heuristic( s ), index( 0 ), numberOfBins( 0 ), maxBinSize( 0 ), numberOfConflicts( 0 ), conflictOccured( false ),
+    strategy( wasp::Options::binpackingStrategy ), bounds( wasp::Options::binpackingBounds ),
+    nrofbinsSignature( UINT_MAX ), maxbinsizeSignature( UINT_MAX ), sizeSignature( UINT_MAX ), vertexBinSignature( UINT_MAX ), backjumpLevel( UINT_MAX )
 {
 }
 
 /*
- * processes the input variables
+ * returns the id of the item named by the given argument of the atom (a new id if the item is new)
  */
-void
-BinPackingHeuristic::processVariable (
-    Var variable )
+unsigned int
+BinPackingHeuristic::getItemId(
+	const Atom& atom,
+	unsigned int argument )
 {
-	string name = VariableNames::getName( variable );
+	unordered_map< unsigned int, unsigned int >::iterator it = itemIds.find( atom.getArgument( argument ) );
+	if ( it != itemIds.end( ) )
+		return it->second;
+
+	Item* item = new Item;
+	item->name = atom.getArgumentName( argument );
+	item->id = items.size( );
+	item->size = 0;
+
+	itemIds[ atom.getArgument( argument ) ] = item->id;
+	items.push_back( item );
+	return item->id;
+}
 
-	name.erase(std::remove(name.begin(),name.end(),' '),name.end());
+/*
+ * returns the id of the bin named by the given argument of the atom (a new id if the bin is new)
+ */
+unsigned int
+BinPackingHeuristic::getBinId(
+	const Atom& atom,
+	unsigned int argument )
+{
+	unordered_map< unsigned int, unsigned int >::iterator it = binIds.find( atom.getArgument( argument ) );
+	if ( it != binIds.end( ) )
+		return it->second;
+
+	unsigned int id = binNames.size( );
+	binIds[ atom.getArgument( argument ) ] = id;
+	binNames.push_back( atom.getArgumentName( argument ) );
+	return id;
+}
 
-	string tmp;
-	string tmp2;
+void
+BinPackingHeuristic::subscribeAtoms(
+	AtomDispatcher& dispatcher )
+{
+	nrofbinsSignature = dispatcher.subscribe( this, "nrofbins", 1 );
+	maxbinsizeSignature = dispatcher.subscribe( this, "maxbinsize", 1 );
+	sizeSignature = dispatcher.subscribe( this, "size", 2 );
+	vertexBinSignature = dispatcher.subscribe( this, "vertex_bin", 2 );
+}
 
-	bool found;
-	unsigned int i;
+/*
+ * processes the input atoms
+ */
+void
+BinPackingHeuristic::onAtom(
+	const Atom& atom )
+{
+	if( atom.getSignature( ) == nrofbinsSignature )
+	{
+		numberOfBins = atom.getNumber( 0 );
 
-	if( name.compare( 0, 9, "nrofbins(" ) == 0 )
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( number of bins )" );
+	}
+	else if( atom.getSignature( ) == maxbinsizeSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
+		maxBinSize = atom.getNumber( 0 );
 
-		numberOfBins = atoi( tmp.c_str( ) );
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( max binsize )" );
+	}
+	else if( atom.getSignature( ) == sizeSignature )
+	{
+		items[ getItemId( atom, 0 ) ]->size = atom.getNumber( 1 );
 
-		trace_msg( heuristic, 3, "Processed variable " << variable << " " << name << " ( number of bins )" );
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( item and size )" );
 	}
-	else if( name.compare( 0, 11, "maxbinsize(" ) == 0 )
+	else if( atom.getSignature( ) == vertexBinSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
+		Item2Bin i2b;
+		i2b.variable = atom.getVariable( );
+		i2b.item = getItemId( atom, 0 );
+		i2b.bin = getBinId( atom, 1 );
 
-		maxBinSize = atoi( tmp.c_str( ) );
+		item2bin.push_back( i2b );
 
-		trace_msg( heuristic, 3, "Processed variable " << variable << " " << name << " ( max binsize )" );
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( vertex bin )" );
 	}
-	else if( name.compare( 0, 5, "size(" ) == 0 )
+}
+
+/*
+ * stores the placements in the flat item/bin table, initializes the bin loads and subscribes
+ * to the placement variables ( the placements already done are notified at once )
+ */
+void
+BinPackingHeuristic::initPlacements(
+	)
+{
+	placementVariables.assign( items.size( ) * binNames.size( ), 0 );
+	tried.assign( items.size( ) * binNames.size( ), false );
+
+	Var maxVariable = 0;
+	for ( const Item2Bin& i2b : item2bin )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
+		placementVariables[ i2b.item * binNames.size( ) + i2b.bin ] = i2b.variable;
+		maxVariable = max( maxVariable, i2b.variable );
+	}
 
-		// check if entry for this vertex already exists (create otherwise)
-		found = false;
-		for ( i = 0; i < items.size( ) && !found; i++ )
-		{
-			if ( items[ i ]->name == tmp )
-			{
-				found = true;
-				items[ i ]->size = atoi( tmp2.c_str( ) );
-			}
-		}
-		if ( !found )
-		{
-			Item* item = new Item;
-			item->name = tmp;
-			item->size = atoi( tmp2.c_str( ) );
+	variablePlacement.assign( maxVariable + 1, UINT_MAX );
+	for ( const Item2Bin& i2b : item2bin )
+		variablePlacement[ i2b.variable ] = i2b.item * binNames.size( ) + i2b.bin;
 
-			items.push_back( item );
-		}
+	item2bin.clear( );
 
-		trace_msg( heuristic, 3, "Processed variable " << variable << " " << name << " ( item and size )" );
+	// items can only go to the bins of the placements, which bound both the capacity and the L2 bound
+	if ( numberOfBins != binNames.size( ) )
+	{
+		trace_msg( heuristic, 2, "Using " << binNames.size( ) << " bins of the placements instead of nrofbins " << numberOfBins );
+		numberOfBins = binNames.size( );
 	}
-	else if( name.compare( 0, 11, "vertex_bin(" ) == 0 )
+
+	placementAssigned.assign( placementVariables.size( ), false );
+	placedIn.assign( items.size( ), UINT_MAX );
+	loads.assign( binNames.size( ), 0 );
+	residuals.init( binNames.size( ), maxBinSize );
+
+	if ( bounds )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
+		for ( Item* item : items )
+			addBoundSize( item->size );
+	}
 
-		Item2Bin* i2b = new Item2Bin;
-		i2b->variable = variable;
-		i2b->bin = tmp2;
-		i2b->item = tmp;
+	for ( Var variable = 1; variable < variablePlacement.size( ); variable++ )
+	{
+		if ( variablePlacement[ variable ] != UINT_MAX )
+			solver.subscribe( this, variable );
+	}
+}
 
-		item2bin.push_back( i2b );
+/*
+ * TRUE if there is a solution possible for the bin/vertex combination of FALSE otherwise
+ */
+bool
+BinPackingHeuristic::isPackingPossible(
+	)
+{
+	unsigned int size = 0;
 
-		Bin* bin = new Bin;
+	for ( Item* item : items )
+	{
+		size += item->size;
+	}
 
-		// check if entry for this bin already exists (create otherwise)
-		found = false;
-		for ( i = 0; i < bins.size( ) && !found; i++ )
-		{
-			if ( bins[ i ]->name == tmp2 )
-			{
-				found = true;
-				bins[ i ]->usedIn.push_back( i2b );
+	if ( size > numberOfBins * maxBinSize )
+		return false;
 
-				bin = bins.back( );
-			}
-		}
-		if ( !found )
-		{
-			bin->name = tmp2;
-			bin->usedIn.push_back( i2b );
+	return true;
+}
 
-			bins.push_back( bin );
-		}
+/*
+ * processes the placements assigned by the solver
+ */
+void
+BinPackingHeuristic::onAssigned(
+	const vector< Literal >& literals )
+{
+	for ( Literal literal : literals )
+	{
+		if ( !literal.isPositive( ) )
+			continue;
 
+		unsigned int placement = variablePlacement[ literal.getVariable( ) ];
+		unsigned int item = placement / binNames.size( );
+		unsigned int bin = placement % binNames.size( );
 
-		Item* item = new Item;
+		placementAssigned[ placement ] = true;
+		placedIn[ item ] = bin;
 
-		// check if entry for this vertex already exists (create otherwise)
-		found = false;
-		for ( i = 0; i < items.size( ) && !found; i++ )
+		// the item and the previous content of the bin become a single content
+		if ( bounds )
 		{
-			if ( items[ i ]->name == tmp )
-			{
-				found = true;
-				items[ i ]->usedIn.push_back( i2b );
-				items[ i ]->correspondingBin.push_back( bin );
-				items[ i ]->tried.push_back( false );
-			}
+			removeBoundSize( items[ item ]->size );
+			removeBoundSize( loads[ bin ] );
+			addBoundSize( loads[ bin ] + items[ item ]->size );
 		}
 
-		if ( !found )
-		{
-			item->name = tmp;
-			item->usedIn.push_back( i2b );
-			item->correspondingBin.push_back( bin );
-			item->tried.push_back( false );
+		loads[ bin ] += items[ item ]->size;
+		updateResidual( bin );
+	}
+}
+
+void
+BinPackingHeuristic::onUnassigned(
+	const vector< Var >& variables )
+{
+	for ( Var variable : variables )
+	{
+		unsigned int placement = variablePlacement[ variable ];
+		if ( !placementAssigned[ placement ] )
+			continue;
 
-			items.push_back( item );
+		unsigned int item = placement / binNames.size( );
+		unsigned int bin = placement % binNames.size( );
+
+		placementAssigned[ placement ] = false;
+		if ( placedIn[ item ] == bin )
+			placedIn[ item ] = UINT_MAX;
+
+		if ( bounds )
+		{
+			removeBoundSize( loads[ bin ] );
+			addBoundSize( loads[ bin ] - items[ item ]->size );
+			addBoundSize( items[ item ]->size );
 		}
 
-		trace_msg( heuristic, 3, "Processed variable " << variable << " " << name << " ( vertex bin )" );
+		loads[ bin ] -= items[ item ]->size;
+		updateResidual( bin );
 	}
 }
 
+void
+BinPackingHeuristic::onUnrollingVariable(
+	Var )
+{
+	if ( solver.getCurrentDecisionLevel( ) < backjumpLevel )
+		backjumpLevel = solver.getCurrentDecisionLevel( );
+}
+
+void
+BinPackingHeuristic::addBoundSize(
+	unsigned int size )
+{
+	if ( size > 0 )
+		boundSizes[ size ]++;
+}
+
+void
+BinPackingHeuristic::removeBoundSize(
+	unsigned int size )
+{
+	if ( size == 0 )
+		return;
+
+	map< unsigned int, unsigned int >::iterator it = boundSizes.find( size );
+	assert( it != boundSizes.end( ) );
+	if ( --it->second == 0 )
+		boundSizes.erase( it );
+}
+
 /*
- * initializes the itemsize for the heursitic
+ * Martello-Toth lower bound L2 on the number of bins needed by the unplaced items
+ * and the contents of the used bins (each content is kept as a single item, which
+ * is a relaxation since the bins are identical). For 0 <= a <= C / 2, with J1 the
+ * sizes > C - a, J2 the sizes in ( C / 2, C - a ] and J3 the sizes in [ a, C / 2 ]:
+ * L( a ) = |J1| + |J2| + max( 0, ceil( ( sum( J3 ) - ( |J2| * C - sum( J2 ) ) ) / C ) ),
+ * and only a = 0 and the sizes in J3 need to be considered.
  */
-void
-BinPackingHeuristic::initItemsize(
-	)
+unsigned int
+BinPackingHeuristic::getLowerBound(
+	) const
 {
-	for ( Item* item : items )
+	uint64_t capacity = maxBinSize;
+	if ( capacity == 0 )
+		return boundSizes.empty( ) ? 0 : UINT_MAX;
+
+	map< unsigned int, unsigned int >::const_iterator firstLarge = boundSizes.upper_bound( maxBinSize / 2 );
+
+	uint64_t numberOfLarge = 0;
+	uint64_t sumOfSmall = 0;
+	for ( map< unsigned int, unsigned int >::const_iterator it = boundSizes.begin( ); it != boundSizes.end( ); ++it )
+	{
+		if ( it->first > maxBinSize / 2 )
+			numberOfLarge += it->second;
+		else
+			sumOfSmall += ( uint64_t ) it->first * it->second;
+	}
+
+	// J2 holds the large sizes up to C - a: the prefix of the large sizes before j2End
+	map< unsigned int, unsigned int >::const_iterator j2End = boundSizes.upper_bound( maxBinSize );
+	uint64_t numberOfJ2 = 0;
+	uint64_t sumOfJ2 = 0;
+	for ( map< unsigned int, unsigned int >::const_iterator it = firstLarge; it != j2End; ++it )
+	{
+		numberOfJ2 += it->second;
+		sumOfJ2 += ( uint64_t ) it->first * it->second;
+	}
+
+	uint64_t bound = 0;
+	uint64_t sumOfJ3 = sumOfSmall;
+	map< unsigned int, unsigned int >::const_iterator small = boundSizes.begin( );
+	unsigned int a = 0;
+	while ( true )
 	{
-		for ( unsigned int i = 0; i < item2bin.size( ); i++ )
+		// sizes above C - a move from J2 to J1
+		while ( j2End != firstLarge )
+		{
+			map< unsigned int, unsigned int >::const_iterator last = j2End;
+			--last;
+			if ( last->first <= maxBinSize - a )
+				break;
+			numberOfJ2 -= last->second;
+			sumOfJ2 -= ( uint64_t ) last->first * last->second;
+			j2End = last;
+		}
+
+		uint64_t freeInJ2 = numberOfJ2 * capacity - sumOfJ2;
+		uint64_t current = numberOfLarge;
+		if ( sumOfJ3 > freeInJ2 )
+			current += ( sumOfJ3 - freeInJ2 + capacity - 1 ) / capacity;
+		bound = max( bound, current );
+
+		if ( small == firstLarge )
+			break;
+
+		// next value of a: the next small size, J3 loses the sizes below it
+		a = small->first;
+		if ( small != boundSizes.begin( ) )
 		{
-			if ( item->name == item2bin[ i ]->item )
-				item2bin[ i ]->itemsize = item->size;
+			map< unsigned int, unsigned int >::const_iterator previous = small;
+			--previous;
+			sumOfJ3 -= ( uint64_t ) previous->first * previous->second;
 		}
+		++small;
 	}
+
+	return bound > UINT_MAX ? UINT_MAX : bound;
 }
 
 /*
- * TRUE if there is a solution possible for the bin/vertex combination of FALSE otherwise
+ * while the lower bound exceeds the number of bins, adds the clause excluding the
+ * current placements (which brings the solver back to level zero), returns false if
+ * the bound is exceeded at level zero
  */
 bool
-BinPackingHeuristic::isPackingPossible(
+BinPackingHeuristic::checkLowerBound(
 	)
 {
-	unsigned int size = 0;
-
-	for ( Item* item : items )
+	while ( getLowerBound( ) > numberOfBins )
 	{
-		size += item->size;
-	}
+		vector< Literal > clause;
+		for ( unsigned int item = 0; item < items.size( ); item++ )
+		{
+			if ( placedIn[ item ] == UINT_MAX )
+				continue;
 
-	if ( size > numberOfBins * maxBinSize )
-		return false;
+			Var variable = getPlacementVariable( item, placedIn[ item ] );
+			if ( solver.getDecisionLevel( variable ) > 0 )
+				clause.push_back( Literal( variable, NEGATIVE ) );
+		}
+
+		trace_msg( heuristic, 2, "Lower bound exceeds the number of bins, adding a clause of size " << clause.size( ) );
+
+		if ( clause.empty( ) || !addClause( clause ) )
+		{
+			setIncoherent( );
+			return false;
+		}
+
+		// the solver is back at level zero: the item trail is emptied on the next backjump
+		numberOfConflicts++;
+	}
 
 	return true;
 }
 
 /*
- * gets the current content size of the given bin
- *
- * @param 	bin		the bin
+ * resets the tried placements of the item, returns false if there were none
  */
-unsigned int
-BinPackingHeuristic::getCurrentBinContentSize(
-	Bin* bin )
+bool
+BinPackingHeuristic::resetTried(
+	Item* item )
 {
-	int current = 0;
+	bool found = false;
 
-	for ( Item2Bin* i2b : bin->usedIn )
+	for ( unsigned int bin = 0; bin < binNames.size( ); bin++ )
 	{
-		if ( solver.getTruthValue( i2b->variable ) == TRUE )
-			current += i2b->itemsize;
+		if ( tried[ item->id * binNames.size( ) + bin ] )
+		{
+			tried[ item->id * binNames.size( ) + bin ] = false;
+			found = true;
+		}
 	}
 
-	return current;
+	return found;
 }
 
 /*
@@ -222,226 +434,283 @@ BinPackingHeuristic::onFinishedParsing (
 	string order = "";
 
 	trace_msg( heuristic, 1, "Initializing bin packing heuristic" );
-	trace_msg( heuristic, 2, "Start processing variables" );
-
-	for ( Var variable : variables )
-	{
-		if ( !VariableNames::isHidden( variable ) )
-			processVariable( variable );
-	}
 
-	initItemsize( );
+	initPlacements( );
 
 	trace_msg( heuristic, 1, "Start heuristic" );
 
 	if ( !isPackingPossible( ) )
 	{
 		trace_msg( heuristic, 2, "Not enough space in all bins for all vertices!");
-		isConsistent = false;
+		setIncoherent( );
 	}
 	else
 	{
 		trace_msg( heuristic, 2, "Creating order" );
 
-		quicksort( items, 0, items.size( ) );
+		sortItems( );
 
-		for ( unsigned int i = 0; i < items.size( ); i++ )
-			order += items[ i ]->name + ", ";
+		for ( unsigned int i = 0; i < sortedItems.size( ); i++ )
+			order += sortedItems[ i ]->name + ", ";
 
 		trace_msg( heuristic, 3, "Considering order " + order );
+
+		seedPhases( );
 	}
 }
 
 /*
- * make choice for solver
+ * computes a packing with the placement strategy (items are already sorted by decreasing size)
+ *
+ * @param bins	the bin of each sorted item, BinResiduals::NONE if it does not fit ( out )
  */
-Literal
-BinPackingHeuristic::makeAChoiceProtected(
-	)
+void
+BinPackingHeuristic::computePacking(
+	vector< unsigned int >& bins ) const
 {
-	Var chosenVariable = 0;
-	Item* current;
-	bool found = false;
-
-	if ( !isConsistent )
-		return Literal::null;
+	BinResiduals seeded;
+	seeded.init( binNames.size( ), maxBinSize );
 
-	// reset index to the first assignment with truth value not TRUE in case of error
-	if ( conflictOccured )
+	bins.clear( );
+	for ( Item* item : sortedItems )
 	{
-		unsigned int conflictIndex = 0;
+		unsigned int chosen = chooseBin( seeded, item, false );
+		if ( chosen != BinResiduals::NONE )
+			seeded.setResidual( chosen, seeded.getResidual( chosen ) - item->size );
+		bins.push_back( chosen );
+	}
+}
+
+/*
+ * seeds the initial phases of the solver with the packing computed by the placement strategy
+ */
+void
+BinPackingHeuristic::seedPhases(
+	)
+{
+	vector< unsigned int > bins;
+	computePacking( bins );
 
-		for ( conflictIndex = 0; conflictIndex < items.size( ) && !found; conflictIndex++ )
+	for ( unsigned int i = 0; i < sortedItems.size( ); i++ )
+	{
+		Item* item = sortedItems[ i ];
+		unsigned int chosen = bins[ i ];
+		if ( chosen == BinResiduals::NONE )
 		{
-			if ( solver.getTruthValue( items[ conflictIndex ]->usedIn[ items[ conflictIndex ]->current ]->variable ) != TRUE )
-			{
-				trace_msg( heuristic, 3, "Reset to item " << items[ conflictIndex ]->name << " due to conflict" );
-				index = conflictIndex;
-				found = true;
-			}
+			trace_msg( heuristic, 3, "No phase seeded for item " << item->name );
+			continue;
 		}
 
-		// reset the list of the tried assignments for all following items
-		found = true;
-		for ( ; conflictIndex < items.size( ) && found; conflictIndex++ )
+		for ( unsigned int bin = 0; bin < binNames.size( ); bin++ )
 		{
-			found = false;
-			for ( unsigned int i = 0; i < items[ conflictIndex ]->tried.size( ); i++ )
-			{
-				if ( items[ conflictIndex ]->tried[ i ] == true )
-				{
-					items[ conflictIndex ]->tried[ i ] = false;
-					found = true;
-				}
-			}
+			Var variable = getPlacementVariable( item->id, bin );
+			if ( variable != 0 )
+				setPhase( Literal( variable, bin == chosen ? POSITIVE : NEGATIVE ) );
 		}
 
+		trace_msg( heuristic, 3, "Seeded phase of item " << item->name << " in bin " << binNames[ chosen ] );
+	}
+}
+
+/*
+ * the placements of the packing computed by the placement strategy, by decreasing size of the items
+ */
+void
+BinPackingHeuristic::getPreferredLiterals(
+	vector< Literal >& literals )
+{
+	vector< unsigned int > bins;
+	computePacking( bins );
+
+	for ( unsigned int i = 0; i < sortedItems.size( ); i++ )
+	{
+		if ( bins[ i ] != BinResiduals::NONE )
+			literals.push_back( Literal( getPlacementVariable( sortedItems[ i ]->id, bins[ i ] ), POSITIVE ) );
+	}
+}
+
+/*
+ * brings the item trail back to the level reached by the last unroll (if any): the
+ * items passed at a higher level are considered again, starting from the first one,
+ * which keeps its tried placements while the following ones forget theirs
+ */
+void
+BinPackingHeuristic::backjump(
+	)
+{
+	if ( backjumpLevel == UINT_MAX )
+		return;
+
+	unsigned int previousSize = itemLevels.size( );
+	while ( !itemLevels.empty( ) && itemLevels.back( ) > backjumpLevel )
+		itemLevels.pop_back( );
+
+	index = itemLevels.size( );
+	backjumpLevel = UINT_MAX;
+
+	for ( unsigned int position = index + 1; position < previousSize; position++ )
+		resetTried( sortedItems[ position ] );
+
+	if ( index < previousSize )
+	{
+		trace_msg( heuristic, 3, "Reset to item " << sortedItems[ index ]->name << " after unrolling" );
+	}
+}
+
+/*
+ * make choice for solver
+ */
+Literal
+BinPackingHeuristic::makeAChoiceProtected(
+	)
+{
+	if ( isIncoherent( ) )
+		return Literal::null;
+
+	if ( bounds && !checkLowerBound( ) )
+	{
+		trace_msg( heuristic, 3, "Bin packing not possible!" );
+		return Literal::null;
+	}
+
+	if ( conflictOccured )
+	{
 		conflictOccured = false;
 		numberOfConflicts++;
 	}
 
-	do
+	backjump( );
+
+	while ( index < sortedItems.size( ) )
 	{
-		chosenVariable = 0;
+		Item* current = sortedItems[ index ];
 
-		do
+		// check if item has already been assigned
+		if ( placedIn[ current->id ] != UINT_MAX )
 		{
-			current = items[ index++ ];
+			trace_msg( heuristic, 3, "Item " << current->name << " is already assigned to bin "
+											 << binNames[ placedIn[ current->id ] ] << " -> continue with next item");
 
-			// check if item has already been assigned
-			found = false;
-			for ( unsigned int i = 0; i < current->usedIn.size( ) && !found; i++ )
-			{
-				if ( solver.getTruthValue( current->usedIn[ i ]->variable ) == TRUE )
-				{
-					found = true;
-					current->tried[ i ] = true;
-					current->current = i;
-
-					trace_msg( heuristic, 3, "Item " << current->name << " is already assigned to bin "
-													 << current->usedIn[ i ]->variable << " " << Literal(current->usedIn[ i ]->variable, POSITIVE)
-													 << " -> continue with next item");
-				}
-			}
+			itemLevels.push_back( solver.getCurrentDecisionLevel( ) );
+			index++;
+			continue;
 		}
-		while( found );
 
-		// find possible assignment
-		found = false;
-		for ( unsigned int i = 0; i < current->usedIn.size() && !found; i++ )
-		{
-			if ( current->tried[ i ] == false &&
-					( getCurrentBinContentSize( current->correspondingBin[ i ] ) + current->size <= maxBinSize ) )
-			{
-				current->tried[ i ] = true;
-				current->current = i;
+		// find possible assignment among the bins with enough residual capacity, trying
+		// again the placements already tried once all of them failed
+		unsigned int bin = chooseBin( residuals, current, true );
+		if ( bin == BinResiduals::NONE && resetTried( current ) )
+			bin = chooseBin( residuals, current, true );
 
-				found = true;
-				chosenVariable = current->usedIn[ i ]->variable;
-			}
-		}
+		// no bin with enough residual capacity: leave the conflict to the solver
+		if ( bin == BinResiduals::NONE )
+			bin = chooseUndefined( current );
 
-		if ( chosenVariable == 0 )
+		if ( bin == BinResiduals::NONE )
 		{
-			trace_msg( heuristic, 3, "Chosen variable is zero"  );
+			trace_msg( heuristic, 3, "No more possibilities to place item " << current->name << " -> continue with next item" );
 
-			if ( index > 1 )
-			{
-				trace_msg( heuristic, 3, "No more possibilities to place this item -> go one step back"  );
-				index -= 2;		// -2 because the index has already been incremented
-
-				while ( solver.getTruthValue( items[ index ]->usedIn[ items[ index ]->current ]->variable) != UNDEFINED )
-					solver.unrollOne( );
-
-				found = true;
-				for ( unsigned int conflictIndex = index + 1 ; conflictIndex < items.size( ) && found; conflictIndex++ )
-				{
-					found = false;
-					for ( unsigned int i = 0; i < items[ conflictIndex ]->tried.size( ); i++ )
-					{
-						if ( items[ conflictIndex ]->tried[ i ] == true )
-						{
-							items[ conflictIndex ]->tried[ i ] = false;
-							found = true;
-						}
-					}
-				}
-			}
-			else
-			{
-				trace_msg( heuristic, 3, "Bin packing not possible!" );
-				return Literal::null;
-			}
+			itemLevels.push_back( solver.getCurrentDecisionLevel( ) );
+			index++;
+			continue;
 		}
-		else
-		{
-			trace_msg( heuristic, 3, "Chosen variable is "<< chosenVariable << " " << Literal( chosenVariable, POSITIVE ) );
 
-			if ( solver.getTruthValue( chosenVariable ) == FALSE )
-			{
-				trace_msg( heuristic, 4, "Chosen variable is already set to FALSE - try another assignment" );
-				index--;
-			}
-			if ( solver.getTruthValue( chosenVariable ) == TRUE )
-			{
-				trace_msg( heuristic, 4, "Chosen variable is already set to TRUE - continue with next node" );
-			}
-		}
+		tried[ current->id * binNames.size( ) + bin ] = true;
+		itemLevels.push_back( solver.getCurrentDecisionLevel( ) + 1 );
+		index++;
+
+		Var chosenVariable = getPlacementVariable( current->id, bin );
+		trace_msg( heuristic, 3, "Chosen variable is "<< chosenVariable << " " << Literal( chosenVariable, POSITIVE ) );
+
+		return Literal( chosenVariable, POSITIVE );
 	}
-	while( chosenVariable == 0 || !solver.isUndefined( chosenVariable ) );
 
-	return Literal( chosenVariable, POSITIVE );
+	trace_msg( heuristic, 3, "All sortedItems are placed" );
+	return Literal::null;
 }
 
 /*
- * Quicksort (DESC) for items according to their size
- *
- * @param 	items	the items
- * @param	p		startindex( 0 )
- * @param 	q		endindex( items.size( ) )
+ * sorts the items by decreasing size (stable, ties keep the input order)
  */
 void
-BinPackingHeuristic::quicksort(
-	vector< Item* >& items,
-	unsigned int p,
-	unsigned int q)
+BinPackingHeuristic::sortItems(
+	)
+{
+	sortedItems = items;
+	stable_sort( sortedItems.begin( ), sortedItems.end( ), []( const Item* a, const Item* b ) { return a->size > b->size; } );
+}
+
+bool
+BinPackingHeuristic::isPlacementAvailable(
+	Item* item,
+	unsigned int bin,
+	bool forChoice ) const
+{
+	unsigned int placement = item->id * binNames.size( ) + bin;
+	if ( placementVariables[ placement ] == 0 )
+		return false;
+
+	return !forChoice || ( !tried[ placement ] && solver.isUndefined( placementVariables[ placement ] ) );
+}
+
+/*
+ * the first bin whose placement of the item is undefined, regardless of its residual
+ * capacity (BinResiduals::NONE if there is none)
+ */
+unsigned int
+BinPackingHeuristic::chooseUndefined(
+	Item* item ) const
 {
-	unsigned int r;
-    if ( p < q )
-    {
-        r = partition ( items, p, q );
-        quicksort ( items, p, r );
-        quicksort ( items, r + 1, q );
-    }
+	for ( unsigned int bin = 0; bin < binNames.size( ); bin++ )
+	{
+		Var variable = getPlacementVariable( item->id, bin );
+		if ( variable != 0 && solver.isUndefined( variable ) )
+			return bin;
+	}
+
+	return BinResiduals::NONE;
 }
 
 /*
- * partitioning method for quicksort
+ * the bin for the item according to the placement strategy, among the bins with
+ * enough residual capacity (BinResiduals::NONE if there is none)
  *
- * @param 	items	the items
- * @param	p		startindex
- * @param 	q		endindex
+ * @param	bins		the residual capacities
+ * @param	item		the item
+ * @param	forChoice	true if the placements already tried or assigned are not considered
  */
-int
-BinPackingHeuristic::partition(
-	vector< Item* >& items,
-	unsigned int p,
-	unsigned int q)
+unsigned int
+BinPackingHeuristic::chooseBin(
+	const BinResiduals& bins,
+	Item* item,
+	bool forChoice ) const
 {
-    Item* item = items[ p ];
-    unsigned int i = p;
-    unsigned int j;
-
-    for ( j = p + 1; j < q; j++ )
-    {
-        if ( items[ j ]->size > item->size )
-        {
-            i = i + 1;
-            swap ( items[ i ], items[ j ] );
-        }
-
-    }
-
-    swap ( items[ i ], items[ p ] );
-    return i;
+	switch ( strategy )
+	{
+		case BINPACKING_BEST_FIT:
+			for ( BinResiduals::Iterator it = bins.fitting( item->size ); it != bins.end( ); ++it )
+			{
+				if ( isPlacementAvailable( item, it->second, forChoice ) )
+					return it->second;
+			}
+			break;
+
+		case BINPACKING_WORST_FIT:
+			for ( BinResiduals::ReverseIterator it = bins.largestFirst( ); it != bins.rend( ) && it->first >= item->size; ++it )
+			{
+				if ( isPlacementAvailable( item, it->second, forChoice ) )
+					return it->second;
+			}
+			break;
+
+		default:
+			for ( unsigned int bin = bins.firstFit( item->size ); bin != BinResiduals::NONE; bin = bins.firstFit( item->size, bin + 1 ) )
+			{
+				if ( isPlacementAvailable( item, bin, forChoice ) )
+					return bin;
+			}
+			break;
+	}
+
+	return BinResiduals::NONE;
 }
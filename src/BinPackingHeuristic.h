@@ -19,6 +19,12 @@
 #ifndef BINPACKINGHEURISTIC_H
 #define	BINPACKINGHEURISTIC_H
 
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BinResiduals.h"
 #include "Heuristic.h"
 
 class BinPackingHeuristic : public Heuristic
@@ -26,66 +32,104 @@ class BinPackingHeuristic : public Heuristic
     public:
 		BinPackingHeuristic( Solver& solver );
         ~BinPackingHeuristic() { };
-        void onNewVariable( Var v ){ variables.push_back( v ); }
+        void onNewVariable( Var ){ }
         void onNewVariableRuntime( Var ){ }
         void onFinishedParsing ( );
         void onLiteralInvolvedInConflict( Literal ){ };
-        void onUnrollingVariable( Var ){ };
+        void onUnrollingVariable( Var v );
         void incrementHeuristicValues( Var ){ };
         void simplifyVariablesAtLevelZero(){ };
         void conflictOccurred(){ conflictOccured = true; }
         unsigned int getTreshold( ){ return numberOfConflicts; }
         void onFinishedSolving( ) { };
+        void subscribeAtoms( AtomDispatcher& dispatcher );
+        void onAtom( const Atom& atom );
+        void getPreferredLiterals( vector< Literal >& literals );
+        void onAssigned( const vector< Literal >& literals );
+        void onUnassigned( const vector< Var >& variables );
 
     protected:
         Literal makeAChoiceProtected();
 
     private:
         unsigned int index;				// current index for the heuristic (items)
-        unsigned int numberOfBins;
+        unsigned int numberOfBins;		// bins of the placements, used by the capacity check and the lower bound
         unsigned int maxBinSize;
         unsigned int numberOfConflicts;
-        bool isConsistent;
         bool conflictOccured;			// true after conflict, otherwise false
+        unsigned int strategy;			// first, best or worst fit
+        bool bounds;					// lower bound pruning
+
+        // signatures of the atoms read
+        unsigned int nrofbinsSignature;
+        unsigned int maxbinsizeSignature;
+        unsigned int sizeSignature;
+        unsigned int vertexBinSignature;
 
         struct Item2Bin
 		{
 			Var variable;
-			string bin;
-			string item;
-			int itemsize;
-		};
-
-        struct Bin
-		{
-        	string name;
-
-        	vector< Item2Bin* > usedIn;
+			unsigned int item;
+			unsigned int bin;
 		};
 
         struct Item
         {
         	string name;
-        	int size;
-
-        	vector< Item2Bin* > usedIn;
-        	vector< Bin* > correspondingBin;
-        	vector< bool > tried;
-        	unsigned int current;
+        	unsigned int id;
+        	unsigned int size;
         };
 
-        vector< Var > variables;
-        vector< Bin* > bins;
-        vector< Item* > items;
-        vector< Item2Bin* > item2bin;
+        vector< Item* > items;			// by id
+        vector< Item* > sortedItems;	// by decreasing size
 
-        void processVariable( Var variable );
-        void initItemsize( );
+        // items and bins, interned to consecutive ids from the ids of their terms
+        unordered_map< unsigned int, unsigned int > itemIds;
+        unordered_map< unsigned int, unsigned int > binIds;
+        vector< string > binNames;
+
+        // atoms collected while parsing
+        vector< Item2Bin > item2bin;
+
+        // per item and bin data, at position item * binNames.size( ) + bin
+        vector< Var > placementVariables;
+        vector< bool > tried;
+
+        // placements assigned by the solver, as notified by it
+        vector< unsigned int > variablePlacement;	// item * binNames.size( ) + bin of each placement variable, UINT_MAX otherwise
+        vector< bool > placementAssigned;			// true if the placement has been processed as true
+        vector< unsigned int > placedIn;			// per item: bin of the processed true placement, UINT_MAX otherwise
+        vector< unsigned int > loads;				// per bin: sizes of the items placed in it
+        BinResiduals residuals;
+
+        // item trail: per item before index (in sorted order), the decision level at which it was
+        // placed by a choice or found placed; it is cut back lazily after the solver unrolls
+        vector< unsigned int > itemLevels;
+        unsigned int backjumpLevel;					// lowest level reached by unrolling since the last choice, UINT_MAX otherwise
+
+        // lower bound: sizes of the unplaced items and loads of the used bins, with multiplicities
+        map< unsigned int, unsigned int > boundSizes;
+
+        unsigned int getItemId( const Atom& atom, unsigned int argument );
+        unsigned int getBinId( const Atom& atom, unsigned int argument );
+        void initPlacements( );
         bool isPackingPossible( );
-        unsigned int getCurrentBinContentSize( Bin* bin );
+        void computePacking( vector< unsigned int >& bins ) const;
+        void seedPhases( );
+
+        Var getPlacementVariable( unsigned int item, unsigned int bin ) const { return placementVariables[ item * binNames.size( ) + bin ]; }
+        void updateResidual( unsigned int bin ) { residuals.setResidual( bin, loads[ bin ] < maxBinSize ? maxBinSize - loads[ bin ] : 0 ); }
+        bool resetTried( Item* item );
+        void sortItems( );
+        unsigned int chooseBin( const BinResiduals& bins, Item* item, bool forChoice ) const;
+        bool isPlacementAvailable( Item* item, unsigned int bin, bool forChoice ) const;
+        unsigned int chooseUndefined( Item* item ) const;
+        void backjump( );
 
-        void quicksort( vector< Item* > &items, unsigned int p, unsigned int q );
-		int partition( vector< Item* > &items, unsigned int p, unsigned int q);
+        void addBoundSize( unsigned int size );
+        void removeBoundSize( unsigned int size );
+        unsigned int getLowerBound( ) const;
+        bool checkLowerBound( );
 };
 
 #endif
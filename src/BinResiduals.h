@@ -0,0 +1,150 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef BINRESIDUALS_H
+#define BINRESIDUALS_H
+
+#include <cassert>
+#include <climits>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Residual capacities of a set of bins, numbered from 0.
+ *
+ * The residuals are kept both in a max segment tree over the bin numbers, for
+ * first fit (the first bin from a given one with enough room), and in a set
+ * ordered by residual, for best and worst fit. Updates and lookups take
+ * O(log bins).
+ */
+class BinResiduals
+{
+    public:
+        typedef set< pair< unsigned int, unsigned int > >::const_iterator Iterator;
+        typedef set< pair< unsigned int, unsigned int > >::const_reverse_iterator ReverseIterator;
+
+        static const unsigned int NONE = UINT_MAX;
+
+        inline BinResiduals() : leaves( 0 ) {}
+
+        inline void init( unsigned int numberOfBins, unsigned int capacity );
+
+        inline unsigned int size() const { return residuals.size(); }
+        inline unsigned int getResidual( unsigned int bin ) const { assert( bin < residuals.size() ); return residuals[ bin ]; }
+        inline void setResidual( unsigned int bin, unsigned int residual );
+
+        /**
+         * The first bin, starting from bin from, with residual at least size (NONE otherwise).
+         */
+        inline unsigned int firstFit( unsigned int size, unsigned int from = 0 ) const;
+
+        /**
+         * Bins with residual at least size, by increasing residual: best fit first.
+         */
+        inline Iterator fitting( unsigned int size ) const { return byResidual.lower_bound( make_pair( size, 0u ) ); }
+        inline Iterator end() const { return byResidual.end(); }
+
+        /**
+         * All bins by decreasing residual: worst fit first.
+         */
+        inline ReverseIterator largestFirst() const { return byResidual.rbegin(); }
+        inline ReverseIterator rend() const { return byResidual.rend(); }
+
+    private:
+        inline unsigned int firstFit( unsigned int node, unsigned int begin, unsigned int end, unsigned int size, unsigned int from ) const;
+
+        vector< unsigned int > residuals;
+        vector< unsigned int > tree;
+        unsigned int leaves;
+        set< pair< unsigned int, unsigned int > > byResidual;
+};
+
+void
+BinResiduals::init(
+    unsigned int numberOfBins,
+    unsigned int capacity )
+{
+    residuals.assign( numberOfBins, capacity );
+
+    leaves = 1;
+    while( leaves < numberOfBins )
+        leaves <<= 1;
+    tree.assign( 2 * leaves, 0 );
+    for( unsigned int i = 0; i < numberOfBins; i++ )
+        tree[ leaves + i ] = capacity;
+    for( unsigned int i = leaves - 1; i > 0; i-- )
+        tree[ i ] = max( tree[ 2 * i ], tree[ 2 * i + 1 ] );
+
+    byResidual.clear();
+    for( unsigned int i = 0; i < numberOfBins; i++ )
+        byResidual.insert( make_pair( capacity, i ) );
+}
+
+void
+BinResiduals::setResidual(
+    unsigned int bin,
+    unsigned int residual )
+{
+    assert( bin < residuals.size() );
+    if( residuals[ bin ] == residual )
+        return;
+
+    byResidual.erase( make_pair( residuals[ bin ], bin ) );
+    byResidual.insert( make_pair( residual, bin ) );
+    residuals[ bin ] = residual;
+
+    unsigned int node = leaves + bin;
+    tree[ node ] = residual;
+    for( node >>= 1; node > 0; node >>= 1 )
+        tree[ node ] = max( tree[ 2 * node ], tree[ 2 * node + 1 ] );
+}
+
+unsigned int
+BinResiduals::firstFit(
+    unsigned int size,
+    unsigned int from ) const
+{
+    if( from >= residuals.size() )
+        return NONE;
+    return firstFit( 1, 0, leaves, size, from );
+}
+
+unsigned int
+BinResiduals::firstFit(
+    unsigned int node,
+    unsigned int begin,
+    unsigned int end,
+    unsigned int size,
+    unsigned int from ) const
+{
+    if( end <= from || tree[ node ] < size )
+        return NONE;
+    if( end - begin == 1 )
+        return begin < residuals.size() ? begin : NONE;
+
+    unsigned int middle = ( begin + end ) / 2;
+    unsigned int bin = firstFit( 2 * node, begin, middle, size, from );
+    if( bin != NONE )
+        return bin;
+    return firstFit( 2 * node + 1, middle, end, size, from );
+}
+
+#endif
@@ -189,7 +189,8 @@ Clause::removeDuplicatesAndFalseAndCheckIfTautological(
             }
             else
             {
-              previousLiteral = literals[ j++ ] = literals[ i ];
+              previousLiteral = literals[ i ];
+              literals.set( j++, previousLiteral );
             }
         }
         
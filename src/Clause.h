@@ -24,7 +24,7 @@
 #include <vector>
 #include <algorithm>
 
-#include "Clause.h"
+#include "ClauseAllocator.h"
 #include "Literal.h"
 #include "Learning.h"
 #include "Reason.h"
@@ -49,12 +49,21 @@ class Clause : public Reason
 
     public:                
         inline ~Clause(){}
-        inline Clause( unsigned reserve = 8 );
 
-        inline Literal getAt( unsigned idx ) const { assert( idx < literals.size() ); return literals[ idx ]; }
-        inline void setAt( unsigned idx, Literal lit ) { assert( idx < literals.size() ); literals[ idx ] = lit; }
-        inline void flipLiteralAt( unsigned idx ) { assert( idx < literals.size() ); literals[ idx ] = literals[ idx ].getOppositeLiteral(); }
-        inline void markAsDeleted() { literals.push_back( literals[ 0 ] ); literals[ 0 ] = Literal::null; }
+        /**
+         * Clauses are allocated by ClauseAllocator, with room for reserve
+         * literals in the same block.
+         */
+        static inline Clause* create( unsigned int reserve = 8 ) { return new ( reserve ) Clause( reserve ); }
+        static inline Clause* get( ClauseRef ref ) { return static_cast< Clause* >( ClauseAllocator::get( ref ) ); }
+        inline ClauseRef getRef() const { return Reason::getRef(); }
+
+        static inline void operator delete( void* p ) { ClauseAllocator::release( p ); }
+
+        inline const Literal getAt( unsigned idx ) const { assert( idx < literals.size() ); return literals[ idx ]; }
+        inline void setAt( unsigned idx, Literal lit ) { assert( idx < literals.size() ); literals.set( idx, lit ); }
+        inline void flipLiteralAt( unsigned idx ) { assert( idx < literals.size() ); literals.set( idx, literals[ idx ].getOppositeLiteral() ); }
+        inline void markAsDeleted() { literals.push_back( literals[ 0 ] ); literals.set( 0, Literal::null ); }
         inline bool hasBeenDeleted() const { assert( !literals.empty() ); return literals[ 0 ] == Literal::null; }
         inline void addLiteral( Literal literal );
         inline void addLiteralInLearnedClause( Literal literal );        
@@ -62,8 +71,7 @@ class Clause : public Reason
         inline bool contains( Literal literal );
         inline bool containsAnyComplementOf( Clause* clause );
 
-        inline Literal operator[]( unsigned int idx ) const { assert_msg( idx < literals.size(), "Index is " << idx << " - literals: " << literals.size() ); return literals[ idx ]; }
-        inline Literal& operator[]( unsigned int idx ) { assert_msg( idx < literals.size(), "Index is " << idx << " - literals: " << literals.size() ); return literals[ idx ]; }
+        inline const Literal operator[]( unsigned int idx ) const { assert_msg( idx < literals.size(), "Index is " << idx << " - literals: " << literals.size() ); return literals[ idx ]; }
 
         inline void removeLiteral( Literal literal );
         inline void removeLastLiteralNoWatches(){ literals.pop_back(); }
@@ -135,7 +143,26 @@ class Clause : public Reason
         inline void setCanBeDeleted( bool b ) { canBeDeleted_ = b; }
         inline bool canBeDeleted() const { return canBeDeleted_; }                
         
+        inline void setTier( unsigned int tier ) { tier_ = tier; }
+        inline unsigned int tier() const { return tier_; }
+        
+        inline void setUsed( bool b ) { used_ = b; }
+        inline bool used() const { return used_; }
+        
         inline void shrink( unsigned int value ) { literals.shrink( value ); } 
+
+        /**
+         * If the literals outgrew the capacity reserved with the clause, move the
+         * clause to a block of its exact size and delete this one. Use only for
+         * clauses that are not referred to by the solver yet.
+         */
+        inline Clause* shrinkToFit();
+
+        /**
+         * A new clause with the literals and the data of this one, in a block of
+         * its exact size.
+         */
+        inline Clause* copy() const;
         
         /* USE ONLY FOR DEBUG */
         inline void printOrderedById()
@@ -153,9 +180,14 @@ class Clause : public Reason
         }
         
     private:
-        Vector< Literal > literals;
-        ostream& print( ostream& out ) const;        
+        inline Clause( unsigned int reserve );
         Clause( const Clause& );
+
+        static inline void* operator new( size_t size, unsigned int reserve ) { return ClauseAllocator::allocate( size + reserve * sizeof( Literal ) ); }
+        static inline void operator delete( void* p, unsigned int ) { ClauseAllocator::release( p ); }
+
+        ClauseLiterals literals;
+        ostream& print( ostream& out ) const;        
         
         union SignatureAct
         {
@@ -178,18 +210,46 @@ class Clause : public Reason
             unsigned positionInSolver       : 30;
         } clauseData;
         
-        unsigned int lbd_ : 31;
+        unsigned int lbd_ : 28;
+        unsigned int tier_ : 2;
+        unsigned int used_ : 1;
         unsigned int canBeDeleted_ : 1;
 };
 
 Clause::Clause(
-    unsigned reserve ) : lbd_( 0 ), canBeDeleted_( 1 )
+    unsigned int reserve ) : Reason( ClauseAllocator::getRef( this ) ), literals( reinterpret_cast< Literal* >( this + 1 ), reserve ), lbd_( 0 ), tier_( LOCAL_TIER ), used_( 0 ), canBeDeleted_( 1 )
 {
-    literals.reserve( reserve );
     clauseData.inQueue = 0;
     clauseData.learned = 0;    
 }
 
+Clause*
+Clause::shrinkToFit()
+{
+    if( literals.isInline() )
+        return this;
+
+    Clause* clause = copy();
+    delete this;
+    return clause;
+}
+
+Clause*
+Clause::copy() const
+{
+    Clause* clause = create( literals.size() );
+    for( unsigned int i = 0; i < literals.size(); i++ )
+        clause->literals.push_back( literals[ i ] );
+    clause->signature_act = signature_act;
+    clause->clauseData = clauseData;
+    clause->lbd_ = lbd_;
+    clause->tier_ = tier_;
+    clause->used_ = used_;
+    clause->canBeDeleted_ = canBeDeleted_;
+    assert( clause->literals.isInline() );
+    return clause;
+}
+
 void
 Clause::addLiteral(
     Literal literal )
@@ -217,7 +277,7 @@ Clause::removeLiteral(
     {
         if( literals[ i ] == literal )
         {
-            literals[ i ] = literals.back();
+            literals.set( i, literals.back() );
             break;
         }
     }
@@ -241,7 +301,7 @@ Clause::swapLiterals(
 {
     assert_msg( pos1 < literals.size(), "First position is out of range: " << pos1 << " of " << literals.size() );
     assert_msg( pos2 < literals.size(), "Second position is out of range: " << pos2 << " of " << literals.size() );
-    std::swap( literals[ pos1 ], literals[ pos2 ] );
+    literals.swap( pos1, pos2 );
 }
 
 void
@@ -356,7 +416,10 @@ Clause::removeDuplicates()
     while( i < literals.size() )
     {
         if( previousLiteral != literals[ i ] )
-            previousLiteral = literals[ j++ ] = literals[ i++ ];
+        {
+            previousLiteral = literals[ i++ ];
+            literals.set( j++, previousLiteral );
+        }
         else
             ++i;
     }
@@ -389,7 +452,8 @@ Clause::removeDuplicatesAndCheckIfTautological()
             }
             else
             {
-               previousLiteral = literals[ j++ ] = literals[ i ];
+               previousLiteral = literals[ i ];
+               literals.set( j++, previousLiteral );
             }
         }
         
@@ -426,6 +490,8 @@ Clause::free()
 //    act = 0.0;
     literals.clear();
     lbd_ = 0;
+    tier_ = LOCAL_TIER;
+    used_ = 0;
     canBeDeleted_ = 1;
 }
 
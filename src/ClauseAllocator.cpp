@@ -0,0 +1,284 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "ClauseAllocator.h"
+#include "util/ErrorMessage.h"
+
+vector< ClauseAllocator::Unit* > ClauseAllocator::chunks;
+vector< unsigned int > ClauseAllocator::freeChunks;
+vector< vector< ClauseAllocator::Unit* > > ClauseAllocator::freeBlocks;
+vector< ClauseAllocator::Span > ClauseAllocator::freeSpans;
+vector< unsigned int > ClauseAllocator::chunkUsed;
+vector< bool > ClauseAllocator::evacuated;
+bool ClauseAllocator::compacting = false;
+unsigned int ClauseAllocator::current = 0;
+unsigned int ClauseAllocator::top = 0;
+unsigned int ClauseAllocator::limit = 0;
+size_t ClauseAllocator::used = 0;
+size_t ClauseAllocator::released = 0;
+size_t ClauseAllocator::releasedSinceCollect = 0;
+
+void*
+ClauseAllocator::allocate(
+    size_t bytes )
+{
+    unsigned int units = 1 + ( bytes + sizeof( Unit ) - 1 ) / sizeof( Unit );
+    used += units;
+
+    if( units > MAX_SMALL_UNITS )
+    {
+        unsigned int chunk = newChunk( units );
+        chunkUsed[ chunk ] = units;
+        Prefix* p = at( chunk, 0 );
+        p->units = units;
+        p->ref = refOf( chunk, 0 );
+        return chunks[ chunk ] + 1;
+    }
+
+    if( !compacting && units < freeBlocks.size() && !freeBlocks[ units ].empty() )
+    {
+        Unit* block = freeBlocks[ units ].back();
+        freeBlocks[ units ].pop_back();
+        released -= units;
+        Prefix* p = ( Prefix* ) block;
+        assert( p->units == ( units | FREE ) );
+        p->units = units;
+        chunkUsed[ chunkOf( p ) ] += units;
+        return block + 1;
+    }
+
+    if( top + units > limit )
+        nextRegion( units );
+
+    chunkUsed[ current ] += units;
+    Prefix* p = at( current, top );
+    p->units = units;
+    p->ref = refOf( current, top );
+    top += units;
+    return ( Unit* ) p + 1;
+}
+
+void
+ClauseAllocator::release(
+    void* block )
+{
+    Prefix* p = prefix( block );
+    unsigned int units = p->units;
+    assert( !( units & FREE ) );
+    assert( used >= units );
+    used -= units;
+    assert( chunkUsed[ chunkOf( p ) ] >= units );
+    chunkUsed[ chunkOf( p ) ] -= units;
+
+    if( units > MAX_SMALL_UNITS )
+    {
+        unsigned int chunk = chunkOf( p );
+        assert( chunk < chunks.size() && chunks[ chunk ] == ( Unit* ) p );
+        delete[] chunks[ chunk ];
+        chunks[ chunk ] = NULL;
+        freeChunks.push_back( chunk );
+        return;
+    }
+
+    p->units = units | FREE;
+    if( units >= freeBlocks.size() )
+        freeBlocks.resize( units + 1 );
+    freeBlocks[ units ].push_back( ( Unit* ) p );
+    released += units;
+    releasedSinceCollect += units;
+}
+
+void
+ClauseAllocator::collect()
+{
+    if( releasedSinceCollect <= used / 4 )
+        return;
+    releasedSinceCollect = 0;
+    closeRegion();
+
+    //Free blocks are found by scanning the chunks, the lists are rebuilt.
+    for( unsigned int i = 0; i < freeBlocks.size(); i++ )
+        freeBlocks[ i ].clear();
+    freeSpans.clear();
+
+    #ifndef NDEBUG
+    size_t inUse = 0;
+    #endif
+    for( unsigned int chunk = 0; chunk < chunks.size(); chunk++ )
+    {
+        if( chunks[ chunk ] == NULL )
+            continue;
+        //A chunk of its own for a large block, which is never free.
+        if( isLarge( chunk ) )
+        {
+            #ifndef NDEBUG
+            inUse += at( chunk, 0 )->units;
+            #endif
+            continue;
+        }
+
+        unsigned int offset = 0;
+        while( offset < CHUNK_UNITS )
+        {
+            unsigned int units = at( chunk, offset )->units;
+            if( !( units & FREE ) )
+            {
+                #ifndef NDEBUG
+                inUse += units;
+                #endif
+                offset += units;
+                continue;
+            }
+
+            unsigned int start = offset;
+            while( offset < CHUNK_UNITS && ( at( chunk, offset )->units & FREE ) )
+                offset += at( chunk, offset )->units & ~FREE;
+            assert( offset <= CHUNK_UNITS );
+
+            if( start == 0 && offset == CHUNK_UNITS )
+            {
+                assert( chunkUsed[ chunk ] == 0 );
+                delete[] chunks[ chunk ];
+                chunks[ chunk ] = NULL;
+                freeChunks.push_back( chunk );
+                released -= CHUNK_UNITS;
+                break;
+            }
+
+            released -= offset - start;
+            addFreeBlock( chunk, start, offset - start );
+        }
+    }
+    assert( inUse == used );
+}
+
+void
+ClauseAllocator::addFreeBlock(
+    unsigned int chunk,
+    unsigned int offset,
+    unsigned int units )
+{
+    Prefix* p = at( chunk, offset );
+    p->units = units | FREE;
+    p->ref = refOf( chunk, offset );
+    released += units;
+
+    if( units > MAX_LISTED_UNITS )
+    {
+        Span span = { chunk, offset, units };
+        freeSpans.insert( upper_bound( freeSpans.begin(), freeSpans.end(), span, []( const Span& a, const Span& b ) { return a.units < b.units; } ), span );
+        return;
+    }
+
+    if( units >= freeBlocks.size() )
+        freeBlocks.resize( units + 1 );
+    freeBlocks[ units ].push_back( ( Unit* ) p );
+}
+
+bool
+ClauseAllocator::beginCompaction()
+{
+    assert( !compacting );
+    if( releasedSinceCollect <= used / 4 )
+        return false;
+
+    //The blocks moved are placed in new chunks, not in the ones to empty.
+    closeRegion();
+    compacting = true;
+    evacuated.assign( chunks.size(), false );
+    for( unsigned int chunk = 0; chunk < chunks.size(); chunk++ )
+        evacuated[ chunk ] = chunks[ chunk ] != NULL && !isLarge( chunk ) && chunkUsed[ chunk ] < CHUNK_UNITS / 2;
+    return true;
+}
+
+void
+ClauseAllocator::endCompaction()
+{
+    assert( compacting );
+    compacting = false;
+    evacuated.clear();
+    collect();
+}
+
+/*
+ * the rest of the current region is left as a free block, to be merged by
+ * collect
+ */
+void
+ClauseAllocator::closeRegion()
+{
+    if( top < limit )
+    {
+        Prefix* p = at( current, top );
+        p->units = ( limit - top ) | FREE;
+        p->ref = refOf( current, top );
+        released += limit - top;
+    }
+    top = limit = 0;
+}
+
+/*
+ * the rest of the current region becomes a free block, the next region is the
+ * largest free run left by collect or a new chunk
+ */
+void
+ClauseAllocator::nextRegion(
+    unsigned int units )
+{
+    if( top < limit )
+        addFreeBlock( current, top, limit - top );
+
+    if( !compacting && !freeSpans.empty() && freeSpans.back().units >= units )
+    {
+        Span span = freeSpans.back();
+        freeSpans.pop_back();
+        released -= span.units;
+        current = span.chunk;
+        top = span.offset;
+        limit = span.offset + span.units;
+        return;
+    }
+
+    current = newChunk( CHUNK_UNITS );
+    top = 0;
+    limit = CHUNK_UNITS;
+}
+
+unsigned int
+ClauseAllocator::newChunk(
+    unsigned int units )
+{
+    unsigned int chunk;
+    if( !freeChunks.empty() )
+    {
+        chunk = freeChunks.back();
+        freeChunks.pop_back();
+    }
+    else
+    {
+        chunk = chunks.size();
+        if( chunk >= MAX_CHUNKS )
+            ErrorMessage::errorGeneric( "Clause allocator exceeded the 32-bit address space" );
+        chunks.push_back( NULL );
+        chunkUsed.push_back( 0 );
+    }
+    assert( chunkUsed[ chunk ] == 0 );
+
+    chunks[ chunk ] = new Unit[ units ];
+    return chunk;
+}
@@ -0,0 +1,223 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef CLAUSEALLOCATOR_H
+#define CLAUSEALLOCATOR_H
+
+#include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+#include "Literal.h"
+#include "util/Assert.h"
+using namespace std;
+
+/**
+ * A 32-bit reference to a clause in the arena of ClauseAllocator (NO_CLAUSE
+ * for none). The highest bit is always 0.
+ */
+typedef unsigned int ClauseRef;
+#define NO_CLAUSE 0
+
+/**
+ * This class allocates clauses, header and literals in one block, from chunks
+ * of memory which are never moved: pointers to clauses stay valid, and each
+ * block is also identified by a 32-bit reference (chunk and offset).
+ * Blocks are carved from a free region of a chunk. Released blocks are kept in
+ * a free list by size and reused by the next blocks of the same size; collect
+ * merges adjacent free blocks, returns the chunks without blocks in use and
+ * makes the large free runs the next regions, so that they are reused by
+ * blocks of any size. Chunks left sparse can be emptied by a compaction, in
+ * which the owners of their blocks move them through ClauseRef.
+ */
+class ClauseAllocator
+{
+    public:
+        /**
+         * Allocate a block of at least the given number of bytes, aligned to
+         * 8 bytes.
+         */
+        static void* allocate( size_t bytes );
+        static void release( void* block );
+
+        /**
+         * Merge the free blocks of each chunk and release the empty chunks.
+         * It does nothing until a quarter of the memory in use has been
+         * released since the last call.
+         */
+        static void collect();
+
+        /**
+         * Compaction after the deletion of learned clauses: if collect is due,
+         * beginCompaction marks the chunks less than half in use and returns
+         * true. Until endCompaction, which collects, blocks are allocated in
+         * new chunks only, so that the owners of the blocks in marked chunks
+         * (see isEvacuated) can move them and release the originals.
+         */
+        static bool beginCompaction();
+        static inline bool isEvacuated( ClauseRef ref ) { return ( ref >> OFFSET_BITS ) < evacuated.size() && evacuated[ ref >> OFFSET_BITS ]; }
+        static void endCompaction();
+
+        static inline ClauseRef getRef( const void* block ) { return prefix( block )->ref; }
+        static inline void* get( ClauseRef ref );
+
+        /**
+         * The number of bytes in blocks in use and in released blocks.
+         */
+        static inline size_t size() { return used * sizeof( Unit ); }
+        static inline size_t wasted() { return released * sizeof( Unit ); }
+
+    private:
+        ClauseAllocator();
+
+        typedef uint64_t Unit;
+
+        /* The unit before each block: its size in units (including this one), FREE if released, and its reference. */
+        struct Prefix
+        {
+            unsigned int units;
+            ClauseRef ref;
+        };
+
+        /* A run of free units in a chunk. */
+        struct Span
+        {
+            unsigned int chunk;
+            unsigned int offset;
+            unsigned int units;
+        };
+
+        static const unsigned int OFFSET_BITS = 17;
+        static const unsigned int CHUNK_UNITS = 1u << OFFSET_BITS;
+        static const unsigned int MAX_CHUNKS = 1u << ( 31 - OFFSET_BITS );
+        /* Larger blocks get a chunk of their own, released with the block. */
+        static const unsigned int MAX_SMALL_UNITS = CHUNK_UNITS >> 4;
+        /* Merged free runs up to this size go to the free lists, the larger ones become regions. */
+        static const unsigned int MAX_LISTED_UNITS = 64;
+        static const unsigned int FREE = 1u << 31;
+
+        static inline Prefix* prefix( const void* block ) { return ( Prefix* ) ( ( const Unit* ) block - 1 ); }
+        static inline Prefix* at( unsigned int chunk, unsigned int offset ) { return ( Prefix* ) ( chunks[ chunk ] + offset ); }
+        static inline ClauseRef refOf( unsigned int chunk, unsigned int offset ) { return ( chunk << OFFSET_BITS ) | ( offset + 1 ); }
+        static inline bool isLarge( unsigned int chunk ) { return at( chunk, 0 )->units > MAX_SMALL_UNITS && !( at( chunk, 0 )->units & FREE ); }
+        static inline unsigned int chunkOf( const Prefix* p ) { return p->ref >> OFFSET_BITS; }
+        static unsigned int newChunk( unsigned int units );
+        static void closeRegion();
+        static void nextRegion( unsigned int units );
+        static void addFreeBlock( unsigned int chunk, unsigned int offset, unsigned int units );
+
+        static vector< Unit* > chunks;
+        static vector< unsigned int > freeChunks;
+        static vector< vector< Unit* > > freeBlocks;
+        /* Free runs too large for the lists, by increasing size. */
+        static vector< Span > freeSpans;
+        /* The units in use in each chunk. */
+        static vector< unsigned int > chunkUsed;
+        /* The chunks to empty during a compaction. */
+        static vector< bool > evacuated;
+        static bool compacting;
+
+        /* The region of a chunk of small blocks where the next blocks are placed. */
+        static unsigned int current;
+        static unsigned int top;
+        static unsigned int limit;
+
+        static size_t used;
+        static size_t released;
+        static size_t releasedSinceCollect;
+};
+
+void*
+ClauseAllocator::get(
+    ClauseRef ref )
+{
+    assert( ref != NO_CLAUSE && ( ref >> OFFSET_BITS ) < chunks.size() );
+    return chunks[ ref >> OFFSET_BITS ] + ( ref & ( CHUNK_UNITS - 1 ) );
+}
+
+/**
+ * The literals of a clause. They are stored right after the clause header, in
+ * the same block, as long as they fit in the capacity reserved with the clause;
+ * otherwise they are moved to a block of their own.
+ * Literals are read and written by value: pointers to them are invalidated
+ * when the clause grows.
+ */
+class ClauseLiterals
+{
+    public:
+        inline ClauseLiterals( Literal* storage, unsigned int capacity ) : data_( storage ), size_( 0 ), capacity_( capacity ), inline_( 1 ) {}
+        inline ~ClauseLiterals() { if( !inline_ ) ClauseAllocator::release( data_ ); }
+
+        inline unsigned int size() const { return size_; }
+        inline bool empty() const { return size_ == 0; }
+        inline bool isInline() const { return inline_; }
+        inline void shrink( unsigned int newSize ) { assert( newSize <= size_ ); size_ = newSize; }
+        inline void push_back( Literal element );
+        inline void pop_back() { assert( !empty() ); --size_; }
+        inline void clear() { size_ = 0; }
+
+        inline const Literal back() const { assert( !empty() ); return data_[ size_ - 1 ]; }
+        inline const Literal operator[]( unsigned int index ) const { assert( index < size_ ); return data_[ index ]; }
+        inline void set( unsigned int index, Literal element ) { assert( index < size_ ); data_[ index ] = element; }
+        inline void swap( unsigned int i, unsigned int j ) { assert( i < size_ && j < size_ ); std::swap( data_[ i ], data_[ j ] ); }
+
+        inline bool existElement( Literal element ) const;
+        inline void sort( int ( *comparator )( Literal a, Literal b ) ) { std::sort( data_, data_ + size_, comparator ); }
+
+    private:
+        ClauseLiterals( const ClauseLiterals& );
+        ClauseLiterals& operator=( const ClauseLiterals& );
+
+        Literal* data_;
+        unsigned int size_;
+        unsigned int capacity_ : 31;
+        unsigned int inline_ : 1;
+};
+
+void
+ClauseLiterals::push_back(
+    Literal element )
+{
+    if( size_ == capacity_ )
+    {
+        unsigned int newCapacity = capacity_ + ( capacity_ >> 1 ) + 2;
+        Literal* tmp = ( Literal* ) ClauseAllocator::allocate( sizeof( Literal ) * newCapacity );
+        memcpy( ( void* ) tmp, data_, sizeof( Literal ) * size_ );
+        if( !inline_ )
+            ClauseAllocator::release( data_ );
+        data_ = tmp;
+        capacity_ = newCapacity;
+        inline_ = 0;
+    }
+    assert( size_ < capacity_ );
+    data_[ size_++ ] = element;
+}
+
+bool
+ClauseLiterals::existElement(
+    Literal element ) const
+{
+    for( unsigned int i = 0; i < size_; ++i )
+        if( data_[ i ] == element )
+            return true;
+    return false;
+}
+
+#endif
@@ -19,269 +19,682 @@
 #include "ColouringHeuristic.h"
 
 #include <algorithm>
+#include <climits>
 #include <iterator>
 #include <string>
 #include <vector>
 #include <time.h>
 
+#include "AtomDispatcher.h"
+#include "HeuristicRegistry.h"
 #include "Solver.h"
 #include "util/Assert.h"
 #include "util/Constants.h"
-#include "util/VariableNames.h"
-#include "util/HeuristicUtil.h"
+
+REGISTER_HEURISTIC( "colouring", ColouringHeuristic );
 
 ColouringHeuristic::ColouringHeuristic(
-    Solver& s ) : Heuristic( s ), index( 0 ), numberOfColours( 0 ), numberOfConflicts( 0 ), conflictOccured( false ), choice( 0 )
+    Solver& s ) : Heuristic( s ), index( 0 ), numberOfColours( 0 ), numberOfConflicts( 0 ), conflictOccured( false ), choice( 0 ),
+    dsatur( wasp::Options::colouringDsatur ), lcv( wasp::Options::colouringLcv ), symmetry( wasp::Options::colouringSymmetry ),
+    symmetryClauses( wasp::Options::colouringSymmetryClauses ),
+    chosenColourSignature( UINT_MAX ), degreeSignature( UINT_MAX ), nrofcolorsSignature( UINT_MAX ), linkSignature( UINT_MAX ), maxBucket( 0 )
+{
+}
+
+/*
+ * returns the id of the vertex named by the given argument of the atom (a new id if the vertex is new)
+ */
+unsigned int
+ColouringHeuristic::getVertexId(
+	const Atom& atom,
+	unsigned int argument )
 {
+	unordered_map< unsigned int, unsigned int >::iterator it = vertexIds.find( atom.getArgument( argument ) );
+	if ( it != vertexIds.end( ) )
+		return it->second;
+
+	unsigned int id = vertexNames.size( );
+	vertexIds[ atom.getArgument( argument ) ] = id;
+	vertexNames.push_back( atom.getArgumentName( argument ) );
+	degrees.push_back( 0 );
+	return id;
 }
 
 /*
- * processes the input variables
+ * returns the id of the colour named by the given argument of the atom (a new id if the colour is new)
  */
+unsigned int
+ColouringHeuristic::getColourId(
+	const Atom& atom,
+	unsigned int argument )
+{
+	unordered_map< unsigned int, unsigned int >::iterator it = colourIds.find( atom.getArgument( argument ) );
+	if ( it != colourIds.end( ) )
+		return it->second;
+
+	unsigned int id = colourNames.size( );
+	colourIds[ atom.getArgument( argument ) ] = id;
+	colourNames.push_back( atom.getArgumentName( argument ) );
+	return id;
+}
+
 void
-ColouringHeuristic::processVariable (
-    Var v )
+ColouringHeuristic::subscribeAtoms(
+	AtomDispatcher& dispatcher )
 {
-	string name = VariableNames::getName( v );
+	chosenColourSignature = dispatcher.subscribe( this, "chosenColour", 2 );
+	degreeSignature = dispatcher.subscribe( this, "degree", 2 );
+	nrofcolorsSignature = dispatcher.subscribe( this, "nrofcolors", 1 );
+	linkSignature = dispatcher.subscribe( this, "link", 2 );
+}
 
-	name.erase(std::remove(name.begin(),name.end(),' '),name.end());
+/*
+ * processes the input atoms
+ */
+void
+ColouringHeuristic::onAtom (
+    const Atom& atom )
+{
+	if( atom.getSignature( ) == chosenColourSignature )
+	{
+		ColourAssignment ca;
+		ca.variable = atom.getVariable( );
+		ca.vertex = getVertexId( atom, 0 );
+		ca.colour = getColourId( atom, 1 );
 
-	string tmp;
-	string tmp2;
+		colourAssignments.push_back( ca );
 
-	bool found;
-	unsigned int i;
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( colour assignment and vertex )" );
+	}
+	else if( atom.getSignature( ) == degreeSignature )
+	{
+		degrees[ getVertexId( atom, 0 ) ] = atom.getNumber( 1 );
 
-	if( name.compare( 0, 13, "chosenColour(" ) == 0 )
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( degree and vertex )" );
+	}
+	else if( atom.getSignature( ) == nrofcolorsSignature )
+	{
+		trace_msg( heuristic, 3, "Processed variable " << atom.getVariable( ) << " ( number of colours " << atom.getArgumentName( 0 ) << " )" );
+	}
+	else if( atom.getSignature( ) == linkSignature )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
+		unsigned int from = getVertexId( atom, 0 );
+		links.push_back( make_pair( from, getVertexId( atom, 1 ) ) );
+	}
+}
 
-		ColourAssignment ca;
-		ca.variable = v;
-		ca.node = tmp;
-		ca.colour = tmp2;
+/*
+ * stores the colour assignments in the flat vertex/colour table
+ */
+void
+ColouringHeuristic::initColourVariables(
+	)
+{
+	numberOfColours = colourNames.size( );
 
-		colourAssignments.push_back( ca );
+	colourVariables.assign( vertexNames.size( ) * numberOfColours, 0 );
+	tried.assign( vertexNames.size( ) * numberOfColours, false );
+	current.assign( vertexNames.size( ), 0 );
+	numberOfTried.assign( vertexNames.size( ), 0 );
 
-		found = false;
-		for ( i = 0; i < vertices.size( ) && !found; i++ )
-		{
-			if ( vertices[ i ].name == tmp )
-			{
-				found = true;
-				vertices[ i ].usedIn.push_back( ca );
-			}
-		}
+	for ( const ColourAssignment& ca : colourAssignments )
+		colourVariables[ ca.vertex * numberOfColours + ca.colour ] = ca.variable;
 
-		if ( !found )
-		{
-			Vertex vertex;
-			vertex.name = tmp;
-			vertex.degree = 0;
-			vertex.current= 0;
-			vertex.usedIn.push_back( ca );
+	colourAssignments.clear( );
+}
 
-			vertices.push_back( vertex );
-		}
+/*
+ * builds the adjacency lists (without duplicates) from the links
+ */
+void
+ColouringHeuristic::initEdges(
+	)
+{
+	unsigned int numberOfVertices = vertexNames.size( );
+
+	trace_msg( heuristic, 2, "Creating vertex connections" );
 
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( colour assignment and vertex )" );
+	neighbourBegin.assign( numberOfVertices + 1, 0 );
+	for ( const pair< unsigned int, unsigned int >& l : links )
+	{
+		if ( l.first == l.second )
+			continue;
+		neighbourBegin[ l.first + 1 ]++;
+		neighbourBegin[ l.second + 1 ]++;
 	}
-	else if( name.compare( 0, 7, "degree(" ) == 0 )
+
+	for ( unsigned int i = 0; i < numberOfVertices; i++ )
+		neighbourBegin[ i + 1 ] += neighbourBegin[ i ];
+
+	vector< unsigned int > position( neighbourBegin.begin( ), neighbourBegin.end( ) - 1 );
+	neighbours.resize( neighbourBegin.back( ) );
+	for ( const pair< unsigned int, unsigned int >& l : links )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
+		if ( l.first == l.second )
+			continue;
+		neighbours[ position[ l.first ]++ ] = l.second;
+		neighbours[ position[ l.second ]++ ] = l.first;
+	}
+	links.clear( );
 
-		found = false;
-		for ( i = 0; i < vertices.size( ) && !found; i++ )
+	// remove duplicates (links may be given in both directions) and compact the lists
+	vector< unsigned int > lastSeen( numberOfVertices, numberOfVertices );
+	unsigned int size = 0;
+	for ( unsigned int i = 0; i < numberOfVertices; i++ )
+	{
+		unsigned int begin = neighbourBegin[ i ];
+		neighbourBegin[ i ] = size;
+		for ( unsigned int j = begin; j < position[ i ]; j++ )
 		{
-			if ( vertices[ i ].name == tmp )
+			if ( lastSeen[ neighbours[ j ] ] != i )
 			{
-				found = true;
-				vertices[ i ].degree = atoi( tmp2.c_str( ) );
+				lastSeen[ neighbours[ j ] ] = i;
+				neighbours[ size++ ] = neighbours[ j ];
 			}
 		}
+	}
+	neighbourBegin[ numberOfVertices ] = size;
+	neighbours.resize( size );
+}
 
-		if ( !found )
-		{
-			Vertex vertex;
-			vertex.name = tmp;
-			vertex.degree = 0;
-			vertex.degree = atoi( tmp2.c_str( ) );
-			vertex.current = 0;
+/*
+ * sorts the vertices by decreasing degree (counting sort) and groups them by degree
+ */
+void
+ColouringHeuristic::initOrder(
+	)
+{
+	unsigned int maxDegree = 0;
+	for ( unsigned int degree : degrees )
+		maxDegree = max( maxDegree, degree );
+
+	vector< unsigned int > count( maxDegree + 2, 0 );
+	for ( unsigned int degree : degrees )
+		count[ maxDegree - degree + 1 ]++;
+	for ( unsigned int i = 1; i < count.size( ); i++ )
+		count[ i ] += count[ i - 1 ];
+
+	order.resize( degrees.size( ) );
+	for ( unsigned int vertex = 0; vertex < degrees.size( ); vertex++ )
+		order[ count[ maxDegree - degrees[ vertex ] ]++ ] = vertex;
+
+	groupBegin.clear( );
+	vertexGroup.resize( order.size( ) );
+	for ( unsigned int i = 0; i < order.size( ); i++ )
+	{
+		if ( i == 0 || degrees[ order[ i ] ] != degrees[ order[ i - 1 ] ] )
+			groupBegin.push_back( i );
+		vertexGroup[ order[ i ] ] = groupBegin.size( ) - 1;
+	}
+	groupBegin.push_back( order.size( ) );
+}
 
-			vertices.push_back( vertex );
-		}
+/*
+ * maps the colour variables to their cells, for following the assignments of the solver
+ */
+void
+ColouringHeuristic::initVariableCells(
+	)
+{
+	Var maxVariable = 0;
+	for ( Var variable : colourVariables )
+		maxVariable = max( maxVariable, variable );
 
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( degree and vertex )" );
-	}
-	else if( name.compare( 0, 11, "nrofcolors(" ) == 0 )
+	variableCell.assign( maxVariable + 1, UINT_MAX );
+	for ( unsigned int cell = 0; cell < colourVariables.size( ); cell++ )
 	{
-		HeuristicUtil::getName( name, &tmp );
+		if ( colourVariables[ cell ] != 0 )
+			variableCell[ colourVariables[ cell ] ] = cell;
+	}
 
-		numberOfColours = atoi( tmp.c_str( ) );
+	cellColoured.assign( colourVariables.size( ), false );
+	colourUsage.assign( numberOfColours, 0 );
+}
 
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( number of colours )" );
-	}
-	else if( name.compare( 0, 5, "link(" ) == 0 )
-	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
+/*
+ * initializes saturation degrees and bucket queue, all vertices uncoloured
+ */
+void
+ColouringHeuristic::initDsatur(
+	)
+{
+	unsigned int numberOfVertices = vertexNames.size( );
+
+	neighbourColours.assign( colourVariables.size( ), 0 );
+	numberOfColourings.assign( numberOfVertices, 0 );
+	saturation.assign( numberOfVertices, 0 );
 
-		Link l;
-		l.vertex1 = tmp;
-		l.vertex2 = tmp2;
+	buckets.assign( ( numberOfColours + 1 ) * numberOfGroups( ), vector< unsigned int >( ) );
+	bucketOf.assign( numberOfVertices, 0 );
+	positionInBucket.assign( numberOfVertices, 0 );
+	inQueue.assign( numberOfVertices, false );
 
-		links.push_back( l );
+	for ( unsigned int vertex = 0; vertex < numberOfVertices; vertex++ )
+	{
+		for ( unsigned int colour = 0; colour < numberOfColours; colour++ )
+		{
+			if ( getColourVariable( vertex, colour ) != 0 )
+			{
+				insertInQueue( vertex );
+				break;
+			}
+		}
 	}
 }
 
 void
-ColouringHeuristic::initEdges(
-	)
+ColouringHeuristic::insertInQueue(
+	unsigned int vertex )
 {
-	Vertex *v1;
-	Vertex *v2;
-	bool found;
+	assert( !inQueue[ vertex ] );
+	unsigned int bucket = getBucket( vertex );
 
-	trace_msg( heuristic, 2, "Creating vertex connections" );
+	bucketOf[ vertex ] = bucket;
+	positionInBucket[ vertex ] = buckets[ bucket ].size( );
+	buckets[ bucket ].push_back( vertex );
+	inQueue[ vertex ] = true;
+
+	if ( bucket > maxBucket )
+		maxBucket = bucket;
+}
+
+void
+ColouringHeuristic::removeFromQueue(
+	unsigned int vertex )
+{
+	assert( inQueue[ vertex ] );
+	vector< unsigned int >& bucket = buckets[ bucketOf[ vertex ] ];
+
+	unsigned int last = bucket.back( );
+	bucket[ positionInBucket[ vertex ] ] = last;
+	positionInBucket[ last ] = positionInBucket[ vertex ];
+	bucket.pop_back( );
+	inQueue[ vertex ] = false;
+}
+
+/*
+ * the colour variable of the cell became true: the vertex leaves the queue and
+ * the saturation of its neighbours is updated
+ */
+void
+ColouringHeuristic::onColoured(
+	unsigned int cell )
+{
+	unsigned int vertex = cell / numberOfColours;
+	unsigned int colour = cell % numberOfColours;
 
-	for ( Link l : links)
+	if ( numberOfColourings[ vertex ]++ == 0 && inQueue[ vertex ] )
+		removeFromQueue( vertex );
+
+	for ( unsigned int i = neighbourBegin[ vertex ]; i < neighbourBegin[ vertex + 1 ]; i++ )
 	{
-		found = false;
-		for ( unsigned int i = 0; i < vertices.size() && !found; i++ )
+		unsigned int neighbour = neighbours[ i ];
+		if ( neighbourColours[ neighbour * numberOfColours + colour ]++ == 0 )
 		{
-			if ( l.vertex1 == vertices[ i ].name )
+			saturation[ neighbour ]++;
+			if ( inQueue[ neighbour ] )
 			{
-				v1 = &vertices[ i ];
-				found = true;
+				removeFromQueue( neighbour );
+				insertInQueue( neighbour );
 			}
 		}
+	}
+}
 
-		found = false;
-		for ( unsigned int i = 0; i < vertices.size() && !found; i++ )
+/*
+ * inverse of onColoured
+ */
+void
+ColouringHeuristic::onUncoloured(
+	unsigned int cell )
+{
+	unsigned int vertex = cell / numberOfColours;
+	unsigned int colour = cell % numberOfColours;
+
+	for ( unsigned int i = neighbourBegin[ vertex ]; i < neighbourBegin[ vertex + 1 ]; i++ )
+	{
+		unsigned int neighbour = neighbours[ i ];
+		if ( --neighbourColours[ neighbour * numberOfColours + colour ] == 0 )
 		{
-			if ( l.vertex2 == vertices[ i ].name )
+			saturation[ neighbour ]--;
+			if ( inQueue[ neighbour ] )
 			{
-				v2 = &vertices[ i ];
-				found = true;
+				removeFromQueue( neighbour );
+				insertInQueue( neighbour );
 			}
 		}
+	}
+
+	if ( --numberOfColourings[ vertex ] == 0 )
+		insertInQueue( vertex );
+}
 
-		if ( std::find( v1->neighbours.begin( ), v1->neighbours.end( ), v2 ) == v1->neighbours.end( ) )
-			v1->neighbours.push_back( v2 );
+/*
+ * initializes the LCV counters, all colour variables undefined
+ */
+void
+ColouringHeuristic::initLcv(
+	)
+{
+	neighbourOptions.assign( colourVariables.size( ), 0 );
 
-		if ( std::find( v2->neighbours.begin( ), v2->neighbours.end( ), v1 ) == v2->neighbours.end( ) )
-			v2->neighbours.push_back( v1 );
+	for ( unsigned int vertex = 0; vertex < vertexNames.size( ); vertex++ )
+	{
+		for ( unsigned int i = neighbourBegin[ vertex ]; i < neighbourBegin[ vertex + 1 ]; i++ )
+		{
+			for ( unsigned int colour = 0; colour < numberOfColours; colour++ )
+			{
+				if ( getColourVariable( neighbours[ i ], colour ) != 0 )
+					neighbourOptions[ vertex * numberOfColours + colour ]++;
+			}
+		}
 	}
 }
 
 /*
- * initialize heuristic after input parsing
+ * the colour variable of the cell has been assigned: the colour is no longer an
+ * option of the vertex for its neighbours
  */
 void
-ColouringHeuristic::onFinishedParsing (
-	)
+ColouringHeuristic::onAssigned(
+	unsigned int cell )
 {
-	string orderOutput = "";
+	unsigned int vertex = cell / numberOfColours;
+	unsigned int colour = cell % numberOfColours;
 
-	trace_msg( heuristic, 1, "Initializing colouring heuristic" );
-	trace_msg( heuristic, 2, "Start processing variables" );
+	for ( unsigned int i = neighbourBegin[ vertex ]; i < neighbourBegin[ vertex + 1 ]; i++ )
+		neighbourOptions[ neighbours[ i ] * numberOfColours + colour ]--;
+}
+
+/*
+ * inverse of onAssigned
+ */
+void
+ColouringHeuristic::onUnassigned(
+	unsigned int cell )
+{
+	unsigned int vertex = cell / numberOfColours;
+	unsigned int colour = cell % numberOfColours;
+
+	for ( unsigned int i = neighbourBegin[ vertex ]; i < neighbourBegin[ vertex + 1 ]; i++ )
+		neighbourOptions[ neighbours[ i ] * numberOfColours + colour ]++;
+}
+
+/*
+ * processes the colour variables assigned by the solver
+ */
+void
+ColouringHeuristic::onAssigned(
+	const vector< Literal >& literals )
+{
+	for ( Literal literal : literals )
+	{
+		unsigned int cell = variableCell[ literal.getVariable( ) ];
+
+		if ( lcv )
+			onAssigned( cell );
+
+		if ( literal.isPositive( ) )
+		{
+			cellColoured[ cell ] = true;
+			colourUsage[ cell % numberOfColours ]++;
+
+			if ( dsatur )
+				onColoured( cell );
+		}
+	}
+}
 
+void
+ColouringHeuristic::onUnassigned(
+	const vector< Var >& variables )
+{
 	for ( Var variable : variables )
 	{
-		if ( !VariableNames::isHidden( variable ) )
-			processVariable( variable );
+		unsigned int cell = variableCell[ variable ];
+
+		if ( cellColoured[ cell ] )
+		{
+			cellColoured[ cell ] = false;
+			colourUsage[ cell % numberOfColours ]--;
+
+			if ( dsatur )
+				onUncoloured( cell );
+		}
+
+		if ( lcv )
+			onUnassigned( cell );
 	}
+}
+
+/*
+ * initialize heuristic after input parsing
+ */
+void
+ColouringHeuristic::onFinishedParsing (
+	)
+{
+	trace_msg( heuristic, 1, "Initializing colouring heuristic" );
 
 	trace_msg( heuristic, 1, "Start heuristic" );
 
-	// for lcv
-	//-------
-//	trace_msg( heuristic, 2, "Initialize edges" );
-//	initEdges( );
-	//-------
+	initColourVariables( );
+	initEdges( );
 
 	trace_msg( heuristic, 2, "Creating order" );
 
-	quicksort( vertices, 0, vertices.size( ) );
+	initOrder( );
+
+	if ( symmetryClauses && !addSymmetryBreakingClauses( ) )
+	{
+		trace_msg( heuristic, 2, "Graph can not be coloured" );
+	}
+
+	if ( followsTrail( ) )
+		initVariableCells( );
 
-	order.push_back( newVertexDegree( ) );
-	order.back( ).degree = vertices[ 0 ].degree;
-	order.back( ).vertices.push_back( &vertices[ 0 ] );
+	if ( dsatur )
+		initDsatur( );
 
-	for ( unsigned int i = 1; i < vertices.size( ); i++ )
+	if ( lcv )
+		initLcv( );
+
+	// the assignments already done are notified at once
+	if ( followsTrail( ) )
 	{
-		if ( vertices[ i ].degree != order.back( ).degree )
+		for ( Var variable : colourVariables )
 		{
-			order.push_back( newVertexDegree( ) );
-			order.back( ).degree = vertices[ i ].degree;
+			if ( variable != 0 )
+				solver.subscribe( this, variable );
 		}
+	}
 
-		order.back( ).vertices.push_back( &vertices[ i ] );
+	trace_action( heuristic, 3, {
+		string orderOutput = "";
+		for ( unsigned int i = 0; i < numberOfGroups( ); i++ )
+		{
+			orderOutput += "with degree " + to_string( degrees[ order[ groupBegin[ i ] ] ] ) + ": ";
+
+			for ( unsigned int j = groupBegin[ i ]; j < groupBegin[ i + 1 ]; j++ )
+				orderOutput += vertexNames[ order[ j ] ] + ", ";
+		}
+		trace_msg( heuristic, 3, "Considering order " + orderOutput );
+	} );
+}
+
+/*
+ * the colour variables of the vertices by decreasing degree, the colours of each vertex in order
+ */
+void
+ColouringHeuristic::getPreferredLiterals(
+	vector< Literal >& literals )
+{
+	for ( unsigned int vertex : order )
+	{
+		for ( unsigned int colour = 0; colour < numberOfColours; colour++ )
+		{
+			Var variable = getColourVariable( vertex, colour );
+			if ( variable != 0 )
+				literals.push_back( Literal( variable, POSITIVE ) );
+		}
 	}
+}
 
-	for ( unsigned int i = 0; i < order.size( ); i++ )
+/*
+ * number of colours to try first: the colours not in use are interchangeable, hence
+ * only the first one after the highest colour in use is worth trying
+ */
+unsigned int
+ColouringHeuristic::getColourLimit(
+	) const
+{
+	if ( !symmetry )
+		return numberOfColours;
+
+	unsigned int limit = numberOfColours;
+	while ( limit > 0 && colourUsage[ limit - 1 ] == 0 )
+		limit--;
+
+	return min( limit + 1, numberOfColours );
+}
+
+/*
+ * greedy clique of at most numberOfColours vertices, following the degree order
+ */
+void
+ColouringHeuristic::findClique(
+	vector< unsigned int >& clique ) const
+{
+	vector< unsigned int > adjacentMembers( vertexNames.size( ), 0 );
+
+	for ( unsigned int i = 0; i < order.size( ) && clique.size( ) < numberOfColours; i++ )
 	{
-		orderOutput += "with degree " + to_string( order[ i ].degree ) + ": ";
+		unsigned int vertex = order[ i ];
+		if ( adjacentMembers[ vertex ] != clique.size( ) )
+			continue;
 
-		for ( unsigned int j = 0; j < order[ i ].vertices.size( ); j++ )
-			orderOutput += order[ i ].vertices[ j ]->name + ", ";
+		clique.push_back( vertex );
+		for ( unsigned int j = neighbourBegin[ vertex ]; j < neighbourBegin[ vertex + 1 ]; j++ )
+			adjacentMembers[ neighbours[ j ] ]++;
 	}
-
-	trace_msg( heuristic, 3, "Considering order " + orderOutput );
 }
 
+/*
+ * breaks the symmetry of the colours: the i-th vertex of a clique gets colour i, and
+ * the other vertices, in degree order after the clique, may only take colours up to
+ * their position. Every colouring can be permuted into one satisfying these clauses.
+ * The clauses are units, added as facts when parsing is over. The permuted colourings
+ * are lost, hence nothing is added when more than one model is requested or when there
+ * are weak constraints, whose costs may depend on colours.
+ * Returns false if the clauses are inconsistent at level zero; the conflict is then
+ * reported by the solver before the search starts.
+ */
 bool
-ColouringHeuristic::addAssignment(
-	Vertex *vertex,
-	Var variable )
+ColouringHeuristic::addSymmetryBreakingClauses(
+	)
 {
-	vertex->current = variable;
+	if ( wasp::Options::maxModels != 1 || solver.isOptimizationProblem( ) )
+	{
+		trace_msg( heuristic, 2, "No symmetry breaking clauses: enumeration or weak constraints" );
+		return true;
+	}
+
+	// colours are interchangeable only if every vertex can take every colour and no colour is fixed yet
+	for ( Var variable : colourVariables )
+	{
+		if ( variable == 0 || !solver.isUndefined( variable ) )
+		{
+			trace_msg( heuristic, 2, "No symmetry breaking clauses: colours are not interchangeable" );
+			return true;
+		}
+	}
 
-	if ( std::find( vertex->tried.begin( ), vertex->tried.end( ), variable ) == vertex->tried.end( ) )
-		vertex->tried.push_back( variable );
+	vector< unsigned int > clique;
+	findClique( clique );
+
+	vector< Literal > units;
+	vector< bool > inClique( vertexNames.size( ), false );
+	for ( unsigned int i = 0; i < clique.size( ); i++ )
+	{
+		units.push_back( Literal( getColourVariable( clique[ i ], i ), POSITIVE ) );
+		inClique[ clique[ i ] ] = true;
+	}
+
+	unsigned int position = clique.size( );
+	for ( unsigned int i = 0; i < order.size( ) && position + 1 < numberOfColours; i++ )
+	{
+		if ( inClique[ order[ i ] ] )
+			continue;
+
+		for ( unsigned int colour = position + 1; colour < numberOfColours; colour++ )
+			units.push_back( Literal( getColourVariable( order[ i ], colour ), NEGATIVE ) );
+		position++;
+	}
+
+	trace_msg( heuristic, 2, "Adding " << units.size( ) << " symmetry breaking clauses ( clique of " << clique.size( ) << " vertices )" );
+
+	for ( Literal literal : units )
+		if ( !solver.addClause( literal ) )
+			return false;
 
 	return true;
 }
 
-bool
-ColouringHeuristic::getTriedAssignments(
-	Vertex* vertex,
-	vector < Var >* tried )
+void
+ColouringHeuristic::addAssignment(
+	unsigned int vertex,
+	unsigned int colour )
 {
-	if ( vertex->tried.size( ) > 0 )
+	current[ vertex ] = getColourVariable( vertex, colour );
+
+	if ( !tried[ vertex * numberOfColours + colour ] )
 	{
-		*tried = vertex->tried;
-		return true;
+		tried[ vertex * numberOfColours + colour ] = true;
+		numberOfTried[ vertex ]++;
 	}
+}
 
-	return false;
+void
+ColouringHeuristic::resetTried(
+	unsigned int vertex )
+{
+	for ( unsigned int colour = 0; colour < numberOfColours; colour++ )
+		tried[ vertex * numberOfColours + colour ] = false;
+	numberOfTried[ vertex ] = 0;
 }
 
 bool
 ColouringHeuristic::getVertexMRV(
-	VertexDegree vd,
+	unsigned int group,
 	unsigned int* mrv )
 {
 	bool found = false;
 	unsigned int mrv_min = numberOfColours + 1;
 	unsigned int mrv_current;
 
-	for ( unsigned int i = 0; i < vd.vertices.size( ); i++ )
+	for ( unsigned int i = groupBegin[ group ]; i < groupBegin[ group + 1 ]; i++ )
 	{
-		if ( vd.vertices[ i ]->current == 0 || solver.getTruthValue( vd.vertices[ i ]->current ) != TRUE )
+		unsigned int vertex = order[ i ];
+
+		if ( current[ vertex ] == 0 || solver.getTruthValue( current[ vertex ] ) != TRUE )
 		{
 			mrv_current = 0;
 
-			for ( ColourAssignment ca : vd.vertices[ i ]->usedIn )
+			for ( unsigned int colour = 0; colour < numberOfColours; colour++ )
 			{
-				if ( solver.getTruthValue( ca.variable ) == UNDEFINED )
+				Var variable = getColourVariable( vertex, colour );
+				if ( variable == 0 )
+					continue;
+
+				if ( solver.getTruthValue( variable ) == UNDEFINED )
 					mrv_current++;
 
-				if ( solver.getTruthValue( ca.variable ) == TRUE )
+				if ( solver.getTruthValue( variable ) == TRUE )
 				{
-					trace_msg( heuristic, 5, "Node " << vd.vertices[ i ]->name << " is already assigned with "
-													 << ca.variable << " " << Literal(ca.variable, POSITIVE) );
+					trace_msg( heuristic, 5, "Node " << vertexNames[ vertex ] << " is already assigned with "
+													 << variable << " " << Literal( variable, POSITIVE ) );
 
-					addAssignment( vd.vertices[ i ], ca.variable );
+					addAssignment( vertex, colour );
 					mrv_current = numberOfColours + 1;
 					break;
 				}
@@ -290,77 +703,127 @@ ColouringHeuristic::getVertexMRV(
 			if ( mrv_current < mrv_min )
 			{
 				mrv_min = mrv_current;
-				*mrv = i;
+				*mrv = vertex;
 				found = true;
 			}
 		}
 	}
 
-	if ( found )
-		return true;
-
-	return false;
+	return found;
 }
 
-// assuming the order of the colours is the same for each vertex in the usedIn vector
+/*
+ * least constraining value: the untried colour of the vertex below limit, not false,
+ * that is still an option for the fewest neighbours
+ */
 bool
-ColouringHeuristic::getVertexLCV(
-	VertexDegree vd,
-	unsigned int mrv,
-	unsigned int* lcv )
+ColouringHeuristic::getColourLCV(
+	unsigned int vertex,
+	unsigned int limit,
+	unsigned int* leastConstraining )
 {
 	bool found = false;
+	unsigned int min = UINT_MAX;
+
+	for ( unsigned int colour = 0; colour < limit; colour++ )
+	{
+		unsigned int cell = vertex * numberOfColours + colour;
+		if ( colourVariables[ cell ] == 0 || tried[ cell ] || solver.getTruthValue( colourVariables[ cell ] ) == FALSE )
+			continue;
+
+		if ( neighbourOptions[ cell ] < min )
+		{
+			found = true;
+			min = neighbourOptions[ cell ];
+			*leastConstraining = colour;
+		}
+	}
 
-	Vertex* v = vd.vertices[ mrv ];
-	unsigned int i, j;
+	return found;
+}
 
-	vector< unsigned int > colourCnt;
-	unsigned int min;
+/*
+ * DSATUR: colour the uncoloured vertex with the highest saturation degree (ties
+ * broken by degree) with its lowest colour not used by the neighbours
+ */
+Literal
+ColouringHeuristic::makeADsaturChoice( )
+{
+	if ( conflictOccured )
+	{
+		conflictOccured = false;
+		numberOfConflicts++;
+	}
 
-	vector< unsigned int > unchecked;
-	vector< unsigned int > unchecked_init;
+	while ( maxBucket > 0 && buckets[ maxBucket ].empty( ) )
+		maxBucket--;
 
-	for ( i = 0; i < numberOfColours; i++ )
+	if ( buckets[ maxBucket ].empty( ) )
 	{
-		colourCnt.push_back( 0 );
-		unchecked_init.push_back( i );
+		trace_msg( heuristic, 3, "All vertices are coloured" );
+		return Literal::null;
 	}
 
-	for ( Vertex* n : v->neighbours )
+	unsigned int vertex = buckets[ maxBucket ].back( );
+	trace_msg( heuristic, 3, "Considering vertex " << vertexNames[ vertex ] << " with saturation " << saturation[ vertex ] );
+
+	unsigned int limit = getColourLimit( );
+	Var fallback = 0;
+	Var spare = 0;
+	Var best = 0;
+	unsigned int bestOptions = UINT_MAX;
+	for ( unsigned int colour = 0; colour < numberOfColours; colour++ )
 	{
-		unchecked = unchecked_init;
-		for ( i = 0; i < numberOfColours; i++ )
+		Var variable = getColourVariable( vertex, colour );
+		if ( variable == 0 || !solver.isUndefined( variable ) )
+			continue;
+
+		// colours beyond the limit are symmetric to the limit one, they are used only if nothing else is left
+		if ( colour >= limit )
 		{
-			for ( j = 0; j < unchecked.size( ); j++ )
+			if ( spare == 0 && neighbourColours[ vertex * numberOfColours + colour ] == 0 )
+				spare = variable;
+		}
+		else if ( neighbourColours[ vertex * numberOfColours + colour ] == 0 )
+		{
+			if ( !lcv )
 			{
-				if ( v->usedIn[ i ].colour.compare( n->usedIn[ unchecked[ j ] ].colour ) == 0 &&
-						solver.getTruthValue( n->usedIn[ unchecked[ j ] ].variable ) == UNDEFINED )
-				{
-					colourCnt[ unchecked[ j ] ]++;
-					unchecked.erase( unchecked.begin( ) + j );
-					break;
-				}
+				trace_msg( heuristic, 3, "Chosen variable is " << variable << " " << Literal( variable, POSITIVE ) );
+				return Literal( variable, POSITIVE );
+			}
+
+			// least constraining value: the colour that is still an option for the fewest neighbours
+			if ( neighbourOptions[ vertex * numberOfColours + colour ] < bestOptions )
+			{
+				best = variable;
+				bestOptions = neighbourOptions[ vertex * numberOfColours + colour ];
 			}
 		}
+
+		if ( fallback == 0 )
+			fallback = variable;
 	}
 
-	min = v->neighbours.size( ) + 1;
+	if ( best != 0 )
+	{
+		trace_msg( heuristic, 3, "Chosen variable is " << best << " " << Literal( best, POSITIVE ) << " ( constraining " << bestOptions << " neighbours )" );
+		return Literal( best, POSITIVE );
+	}
 
-	for ( i = 0; i < numberOfColours; i++ )
+	if ( spare != 0 )
 	{
-		if ( colourCnt[ i ] < min && solver.getTruthValue( v->usedIn[ i ].variable ) != FALSE &&
-				std::find( v->tried.begin( ), v->tried.end( ), v->usedIn[ i ].variable ) == v->tried.end( ) )
-		{
-			found = true;
-			min = colourCnt[ i ];
-			*lcv = i;
-		}
+		trace_msg( heuristic, 3, "Chosen variable is " << spare << " " << Literal( spare, POSITIVE ) << " ( colour beyond the highest used one )" );
+		return Literal( spare, POSITIVE );
 	}
 
-	if ( found )
-		return true;
+	if ( fallback == 0 )
+	{
+		trace_msg( heuristic, 3, "No colour left for vertex " << vertexNames[ vertex ] );
+		return Literal::null;
+	}
 
-	return false;
+	trace_msg( heuristic, 3, "Chosen variable is " << fallback << " " << Literal( fallback, POSITIVE ) << " ( colour used by a neighbour )" );
+	return Literal( fallback, POSITIVE );
 }
 
 /*
@@ -369,43 +832,36 @@ ColouringHeuristic::getVertexLCV(
 Literal
 ColouringHeuristic::makeAChoiceProtected( )
 {
-	VertexDegree current;
-	Vertex* currentVertex;
+	unsigned int currentVertex = 0;
 	Var chosenVariable;
 	bool found = false;
-	unsigned int mrv;
 
-	do
-	{
-//		cout << endl << "assignments" << endl;
-//		for ( unsigned int i = 0; i < vertices.size( ); i++ )
-//		{
-//			if ( vertices[ i ].current != 0 )
-//				cout << i << ": " << VariableNames::getName( vertices[ i ].current ) << " is " <<
-//						solver.getTruthValue( vertices[ i ].current ) << endl;
-//		}
-//		cout << endl;
+	if ( numberOfColours == 0 || order.empty( ) )
+		return Literal::null;
 
-		if ( index >= order.size( ) )
-			assert ( 0 && "assert index" );
+	if ( dsatur )
+		return makeADsaturChoice( );
 
+	do
+	{
 		if ( conflictOccured )
 		{
 			bool indexReseted = false;
-			unsigned int maxIndex = index;
+			unsigned int maxIndex = min( index, numberOfGroups( ) - 1 );
 
 			for ( unsigned int i = 0; i <= maxIndex; i++ )
 			{
-				for ( unsigned int j = 0; j < order[ i ].vertices.size( ); j++ )
+				for ( unsigned int j = groupBegin[ i ]; j < groupBegin[ i + 1 ]; j++ )
 				{
-					if ( order[ i ].vertices[ j ]->current != 0 && solver.getTruthValue( order[ i ].vertices[ j ]->current ) != TRUE )
+					unsigned int vertex = order[ j ];
+					if ( current[ vertex ] != 0 && solver.getTruthValue( current[ vertex ] ) != TRUE )
 					{
-						order[ i ].vertices[ j ]->current = 0;
-						order[ i ].vertices[ j ]->tried.clear( );
+						current[ vertex ] = 0;
+						resetTried( vertex );
 
 						if ( !indexReseted )
 						{
-							trace_msg( heuristic, 4, "Reset index to vertex group with degree " << order[ index ].degree << " due to conflict" );
+							trace_msg( heuristic, 4, "Reset index to vertex group with degree " << degrees[ order[ groupBegin[ index ] ] ] << " due to conflict" );
 							index = i;
 							indexReseted = true;
 						}
@@ -421,18 +877,22 @@ ColouringHeuristic::makeAChoiceProtected( )
 
 		do
 		{
-			current = order[ index ];
-			trace_msg( heuristic, 2, "Looking for uncoloured vertex with degree " << to_string( current.degree ) );
+			if ( index >= numberOfGroups( ) )
+			{
+				trace_msg( heuristic, 3, "All vertices are coloured" );
+				return Literal::null;
+			}
+
+			trace_msg( heuristic, 2, "Looking for uncoloured vertex with degree " << to_string( degrees[ order[ groupBegin[ index ] ] ] ) );
 
-			found = getVertexMRV( current, &mrv );
+			found = getVertexMRV( index, &currentVertex );
 			if ( found )
 			{
-				currentVertex = order[ index ].vertices[ mrv ];
-				trace_msg( heuristic, 3, "Considering vertex " << currentVertex->name );
+				trace_msg( heuristic, 3, "Considering vertex " << vertexNames[ currentVertex ] );
 			}
 			else
 			{
-				trace_msg( heuristic, 3, "No uncolored vertex left with degree " << to_string( current.degree ) << ". Continue with next degree." );
+				trace_msg( heuristic, 3, "No uncolored vertex left with degree " << to_string( degrees[ order[ groupBegin[ index ] ] ] ) << ". Continue with next degree." );
 				index++;
 			}
 		}
@@ -441,42 +901,45 @@ ColouringHeuristic::makeAChoiceProtected( )
 		found = false;
 		chosenVariable = 0;
 
-		// for lcv
-		//-------
-//		if ( getVertexLCV( current, mrv, &choice ) )
-//		{
-//			chosenVariable = currentVertex->usedIn[ choice ].variable;
-//			addAssignment( currentVertex, chosenVariable );
-//		}
-		//-------
-
-		// without lcv
-		//-------
-		vector < Var > tried;
-
-		choice = (choice + 1) % numberOfColours;
-		if ( !getTriedAssignments( currentVertex, &tried ) )
+		unsigned int limit = getColourLimit( );
+
+		if ( lcv )
 		{
-			chosenVariable = currentVertex->usedIn[ choice ].variable;
-			addAssignment( currentVertex, chosenVariable );
+			unsigned int colour;
+			if ( getColourLCV( currentVertex, limit, &colour ) || getColourLCV( currentVertex, numberOfColours, &colour ) )
+			{
+				chosenVariable = getColourVariable( currentVertex, colour );
+				addAssignment( currentVertex, colour );
+			}
+		}
+		else
+		{
+			choice = (choice + 1) % limit;
+			if ( numberOfTried[ currentVertex ] == 0 && getColourVariable( currentVertex, choice ) != 0 )
+			{
+				chosenVariable = getColourVariable( currentVertex, choice );
+				addAssignment( currentVertex, choice );
+			}
 		}
 
-		if ( chosenVariable == 0 )
+		if ( chosenVariable == 0 && !lcv )
 		{
-			for ( unsigned int i = 0; i < numberOfColours && !found; i++ )
+			// the first round considers only the colours below the limit
+			for ( unsigned int i = 0; i < 2 * numberOfColours && !found; i++ )
 			{
 				unsigned int pos = ( i + choice ) % numberOfColours;
+				if ( i < numberOfColours && pos >= limit )
+					continue;
 
-				if ( ( std::find( tried.begin(), tried.end(), currentVertex->usedIn[ pos ].variable ) == tried.end() ) )
+				if ( getColourVariable( currentVertex, pos ) != 0 && !tried[ currentVertex * numberOfColours + pos ] )
 				{
-					chosenVariable = currentVertex->usedIn[ pos ].variable;
-					addAssignment( currentVertex, chosenVariable );
+					chosenVariable = getColourVariable( currentVertex, pos );
+					addAssignment( currentVertex, pos );
 
 					found = true;
 				}
 			}
 		}
-		//-------
 
 		if ( chosenVariable == 0 )
 		{
@@ -507,56 +970,3 @@ ColouringHeuristic::makeAChoiceProtected( )
 
 	return Literal( chosenVariable, POSITIVE );
 }
-
-/*
- * Quicksort (DESC) for items according to their size
- *
- * @param 	items	the items
- * @param	p		startindex( 0 )
- * @param 	q		endindex( items.size( ) )
- */
-void
-ColouringHeuristic::quicksort(
-	vector< Vertex >& vertices,
-	unsigned int p,
-	unsigned int q)
-{
-	unsigned int r;
-    if ( p < q )
-    {
-        r = partition ( vertices, p, q );
-        quicksort ( vertices, p, r );
-        quicksort ( vertices, r + 1, q );
-    }
-}
-
-/*
- * partitioning method for quicksort
- *
- * @param 	items	the items
- * @param	p		startindex
- * @param 	q		endindex
- */
-int
-ColouringHeuristic::partition(
-	vector< Vertex >& vertices,
-	unsigned int p,
-	unsigned int q)
-{
-    Vertex vertex = vertices[ p ];
-    unsigned int i = p;
-    unsigned int j;
-
-    for ( j = p + 1; j < q; j++ )
-    {
-        if ( vertices[ j ].degree > vertex.degree )
-        {
-            i = i + 1;
-            swap ( vertices[ i ], vertices[ j ] );
-        }
-
-    }
-
-    swap ( vertices[ i ], vertices[ p ] );
-    return i;
-}
@@ -19,6 +19,11 @@
 #ifndef COLOURINGHEURISTIC_H
 #define	COLOURINGHEURISTIC_H
 
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "Heuristic.h"
 #include "util/VariableNames.h"
 
@@ -27,78 +32,130 @@ class ColouringHeuristic : public Heuristic
     public:
 		ColouringHeuristic( Solver& solver );
         ~ColouringHeuristic() { };
-        void onNewVariable( Var v ) { variables.push_back( v ); }
+        void onNewVariable( Var ) { }
         void onNewVariableRuntime( Var ) { };
         void onFinishedParsing ( );
         void onLiteralInvolvedInConflict( Literal ){ }
-        void onUnrollingVariable( Var ){ }
+        void onUnrollingVariable( Var ) { }
         void incrementHeuristicValues( Var ){ }
         void simplifyVariablesAtLevelZero( ){ }
         void conflictOccurred(){ conflictOccured = true; }
         unsigned int getTreshold( ){ return numberOfConflicts; };
         void onFinishedSolving( ) { };
+        void subscribeAtoms( AtomDispatcher& dispatcher );
+        void onAtom( const Atom& atom );
+        void getPreferredLiterals( vector< Literal >& literals );
+        void onAssigned( const vector< Literal >& literals );
+        void onUnassigned( const vector< Var >& variables );
 
     protected:
         Literal makeAChoiceProtected();
 
     private:
-        unsigned int index;
+        unsigned int index;				// current degree group
         unsigned int numberOfColours;
         unsigned int numberOfConflicts;
         bool conflictOccured;
 
         unsigned int choice;
 
-        struct ColourAssignment
-		{
-			Var variable;
-			string node;
-			string colour;
-		};
+        bool dsatur;					// DSATUR mode instead of the static degree order
+        bool lcv;						// least constraining value ordering of the colours
+        bool symmetry;					// colours beyond the highest used one plus one are tried last
+        bool symmetryClauses;			// symmetry breaking clauses are added after parsing
 
-        struct Link
-        {
-        	string vertex1;
-        	string vertex2;
-        };
+        // signatures of the atoms read
+        unsigned int chosenColourSignature;
+        unsigned int degreeSignature;
+        unsigned int nrofcolorsSignature;
+        unsigned int linkSignature;
 
-        struct Vertex
+        struct ColourAssignment
 		{
-			string name;
-			unsigned int degree;
-
-			vector< Vertex* > neighbours;
-
-			vector< ColourAssignment > usedIn;
-
-			Var current;
-			vector < Var > tried;
+			Var variable;
+			unsigned int vertex;
+			unsigned int colour;
 		};
 
-        struct VertexDegree
-        {
-        	unsigned int degree;
-        	vector< Vertex* > vertices;
-        };
+        // vertices and colours, interned to consecutive ids from the ids of their terms
+        unordered_map< unsigned int, unsigned int > vertexIds;
+        unordered_map< unsigned int, unsigned int > colourIds;
+        vector< string > vertexNames;
+        vector< string > colourNames;
 
-        vector< Link > links;
-        vector< Var > variables;
-        vector< Vertex > vertices;
+        // atoms collected while parsing
         vector< ColourAssignment > colourAssignments;
-
-        vector< VertexDegree > order;
-
-        void processVariable( Var v );
+        vector< pair< unsigned int, unsigned int > > links;
+
+        // per vertex data
+        vector< unsigned int > degrees;
+        vector< Var > current;
+        vector< unsigned int > numberOfTried;
+
+        // per vertex and colour data, at position vertex * numberOfColours + colour
+        vector< Var > colourVariables;
+        vector< bool > tried;
+
+        // adjacency lists in compressed sparse row form
+        vector< unsigned int > neighbourBegin;
+        vector< unsigned int > neighbours;
+
+        // vertices by decreasing degree, group i is order[ groupBegin[ i ] .. groupBegin[ i + 1 ] )
+        vector< unsigned int > order;
+        vector< unsigned int > groupBegin;
+        vector< unsigned int > vertexGroup;
+
+        // colour variables assigned by the solver, as notified by it (DSATUR, LCV and symmetry)
+        vector< unsigned int > variableCell;		// vertex * numberOfColours + colour of each colour variable, UINT_MAX otherwise
+        vector< bool > cellColoured;				// true if the colour variable of the cell has been processed as true
+        vector< unsigned int > colourUsage;			// per colour: vertices processed as coloured with it
+
+        // DSATUR mode
+        vector< unsigned int > numberOfColourings;	// processed true colour variables of each vertex
+        vector< unsigned int > neighbourColours;	// per vertex and colour: coloured neighbours with that colour
+        vector< unsigned int > saturation;			// per vertex: distinct colours of the neighbours
+
+        // bucket queue of the uncoloured vertices, by saturation and then by degree
+        vector< vector< unsigned int > > buckets;
+        vector< unsigned int > bucketOf;
+        vector< unsigned int > positionInBucket;
+        vector< bool > inQueue;
+        unsigned int maxBucket;
+
+        // LCV: per vertex and colour, neighbours for which the colour is still undefined
+        vector< unsigned int > neighbourOptions;
+
+        unsigned int getVertexId( const Atom& atom, unsigned int argument );
+        unsigned int getColourId( const Atom& atom, unsigned int argument );
+        void initColourVariables( );
         void initEdges( );
-
-        VertexDegree newVertexDegree( ){ VertexDegree vd; return vd; }
-
-        bool getVertexMRV( VertexDegree vd, unsigned int* mrv );
-        bool getVertexLCV( VertexDegree vd, unsigned int mrv, unsigned int* lcv );
-        bool addAssignment( Vertex *vertex, Var variable );
-        bool getTriedAssignments( Vertex* vertex, vector < Var >* tried );
-        void quicksort( vector< Vertex > &vertices, unsigned int p, unsigned int q );
-        int partition( vector< Vertex > &vertices, unsigned int p, unsigned int q);
+        void initOrder( );
+
+        unsigned int numberOfGroups( ) const { return groupBegin.size( ) - 1; }
+        Var getColourVariable( unsigned int vertex, unsigned int colour ) const { return colourVariables[ vertex * numberOfColours + colour ]; }
+
+        bool followsTrail( ) const { return dsatur || lcv || symmetry; }
+        unsigned int getColourLimit( ) const;
+
+        void initVariableCells( );
+        void initDsatur( );
+        void initLcv( );
+        void onAssigned( unsigned int cell );
+        void onUnassigned( unsigned int cell );
+        void onColoured( unsigned int cell );
+        void onUncoloured( unsigned int cell );
+        unsigned int getBucket( unsigned int vertex ) const { return saturation[ vertex ] * numberOfGroups( ) + numberOfGroups( ) - 1 - vertexGroup[ vertex ]; }
+        void insertInQueue( unsigned int vertex );
+        void removeFromQueue( unsigned int vertex );
+        Literal makeADsaturChoice( );
+        bool getColourLCV( unsigned int vertex, unsigned int limit, unsigned int* leastConstraining );
+
+        void findClique( vector< unsigned int >& clique ) const;
+        bool addSymmetryBreakingClauses( );
+
+        bool getVertexMRV( unsigned int group, unsigned int* mrv );
+        void addAssignment( unsigned int vertex, unsigned int colour );
+        void resetTried( unsigned int vertex );
 };
 
 #endif
@@ -17,14 +17,16 @@
  */
 
 #include "CombinedHeuristic.h"
-#include "MinisatHeuristic.h"
-#include "PUPHeuristic.h"
-#include "ColouringHeuristic.h"
-#include "BinPackingHeuristic.h"
-#include "util/HeuristicUtil.h"
+
+#include <cmath>
+
+#include "HeuristicRegistry.h"
+#include "util/Options.h"
+#include "util/Trace.h"
 
 CombinedHeuristic::CombinedHeuristic(
-    Solver& s ) : Heuristic( s ), index( 0 )
+    Solver& s ) : Heuristic( s ), index( 0 ), plays( 1, 0 ), rewards( 1, 0 ), totalPlays( 0 ), choices( 0 ), conflicts( 0 ), maxAssigned( 0 ),
+	seeding( wasp::Options::heuristicSeeding )
 {
 	minisat = new MinisatHeuristic( s );
 }
@@ -107,24 +109,29 @@ CombinedHeuristic::conflictOccurred(
 	minisat->conflictOccurred( );
 }
 
+/*
+ * The choice of the arm in use: a domain heuristic that has nothing left to choose
+ * leaves the remaining choices of the restart to minisat
+ */
 Literal
 CombinedHeuristic::makeAChoiceProtected(
 	)
 {
-	Literal lit = Literal::null;
-
-	if ( index < heuristics.size( ) && getTresholdStatistics( ) >= 100 )
-		index++;
+	choices++;
+	if ( solver.numberOfAssignedLiterals( ) > maxAssigned )
+		maxAssigned = solver.numberOfAssignedLiterals( );
 
-	while ( lit == Literal::null && index < heuristics.size( ) )
+	if ( !seeding && index < heuristics.size( ) )
 	{
-		lit = heuristics[ index ]->makeAChoice( );
-		if ( lit == Literal::null )
-			index++;
-		else
+		Literal lit = heuristics[ index ]->makeAChoice( );
+		if ( lit != Literal::null || heuristics[ index ]->isIncoherent( ) )
 			return lit;
 	}
 
+	// a domain heuristic may have added clauses that are inconsistent at level zero
+	if ( solver.conflictDetected( ) )
+		return Literal::null;
+
 	return minisat->makeAChoice( );
 }
 
@@ -136,6 +143,122 @@ CombinedHeuristic::onFinishedParsing(
 
 	for ( Heuristic* h : heuristics )
 		h->onFinishedParsing( );
+
+	if ( seeding )
+		seedMinisat( );
+}
+
+/*
+ * Seeds minisat with the preferred literals of the domain heuristics, in the order of
+ * the heuristics: a variable keeps the activity and the phase of its first literal
+ */
+void
+CombinedHeuristic::seedMinisat(
+	)
+{
+	vector< Literal > literals;
+	for ( Heuristic* h : heuristics )
+		h->getPreferredLiterals( literals );
+
+	vector< bool > seeded( solver.numberOfVariables( ) + 1, false );
+	for ( Literal lit : literals )
+	{
+		if ( seeded[ lit.getVariable( ) ] )
+			continue;
+
+		seeded[ lit.getVariable( ) ] = true;
+		setPhase( lit );
+	}
+
+	minisat->seedActivities( literals );
+	index = heuristics.size( );
+
+	trace_msg( heuristic, 1, "Seeded minisat with " << literals.size( ) << " literals" );
+}
+
+/*
+ * Restarts are the only points where the arm changes: the reward of the restart goes to
+ * the arm in use, and the next arm is selected by UCB1 over the domain heuristics and minisat
+ */
+void
+CombinedHeuristic::onRestart(
+	)
+{
+	minisat->onRestart( );
+
+	for ( Heuristic* h : heuristics )
+		h->onRestart( );
+
+	if ( seeding )
+		return;
+
+	if ( choices > 0 )
+	{
+		double reward = getReward( );
+		plays[ index ]++;
+		rewards[ index ] += reward;
+		totalPlays++;
+
+		trace_msg( heuristic, 2, "Restart with arm " << index << " after " << choices << " choices: reward " << reward );
+	}
+
+	index = selectArm( );
+	choices = 0;
+	conflicts = solver.getNumberOfConflicts( );
+	maxAssigned = solver.numberOfAssignedLiterals( );
+
+	trace_msg( heuristic, 1, "Using arm " << index << ( index < heuristics.size( ) ? "" : " ( minisat )" ) );
+}
+
+/*
+ * The reward of the restart, in [ 0, 1 ]: the mean of the choices that did not end in a
+ * conflict and of the largest fraction of the variables assigned
+ */
+double
+CombinedHeuristic::getReward(
+	) const
+{
+	double conflictsPerChoice = (double) ( solver.getNumberOfConflicts( ) - conflicts ) / choices;
+	double progress = solver.numberOfVariables( ) == 0 ? 1 : (double) maxAssigned / solver.numberOfVariables( );
+
+	return ( ( 1 - min( conflictsPerChoice, 1.0 ) ) + progress ) / 2;
+}
+
+/*
+ * The arms not played yet in order ( the domain heuristics first ), then the arm with the
+ * best upper confidence bound
+ */
+unsigned int
+CombinedHeuristic::selectArm(
+	) const
+{
+	for ( unsigned int i = 0; i < plays.size( ); i++ )
+	{
+		if ( plays[ i ] == 0 )
+			return i;
+	}
+
+	unsigned int best = 0;
+	double bestBound = -1;
+	for ( unsigned int i = 0; i < plays.size( ); i++ )
+	{
+		double bound = rewards[ i ] / plays[ i ] + sqrt( 2 * log( (double) totalPlays ) / plays[ i ] );
+		if ( bound > bestBound )
+		{
+			best = i;
+			bestBound = bound;
+		}
+	}
+
+	return best;
+}
+
+void
+CombinedHeuristic::subscribeAtoms(
+	AtomDispatcher& dispatcher )
+{
+	for ( Heuristic* h : heuristics )
+		h->subscribeAtoms( dispatcher );
 }
 
 void
@@ -143,23 +266,19 @@ CombinedHeuristic::addHeuristic(
 	Heuristic* h )
 {
 	heuristics.push_back( h );
+	plays.push_back( 0 );
+	rewards.push_back( 0 );
 }
 
 bool
 CombinedHeuristic::addHeuristic(
 	string h )
 {
-	std::transform(h.begin(), h.end(), h.begin(), HeuristicUtil::tolower);
-
-	if ( h == "pup" )
-		heuristics.push_back( new PUPHeuristic( solver ) );
-	else if ( h == "colouring" )
-		heuristics.push_back( new ColouringHeuristic( solver ) );
-	else if ( h == "binpacking" )
-		heuristics.push_back( new BinPackingHeuristic( solver ) );
-	else
+	Heuristic* heuristic = HeuristicRegistry::create( h, solver );
+	if ( heuristic == NULL )
 		return false;
 
+	addHeuristic( heuristic );
 	return true;
 }
 
@@ -172,14 +291,3 @@ CombinedHeuristic::getTreshold(
 	else
 		return minisat->getTreshold( );
 };
-
-double
-CombinedHeuristic::getTresholdStatistics(
-	)
-{
-#ifdef STATS_ON
-	return (double) solver.getNumberOfRestarts( ) / solver.getNumberOfChoices( );
-#else
-	return getTreshold( );
-#endif
-}
@@ -20,6 +20,7 @@
 #define	COMBINEDHEURISTIC_H
 
 #include "Heuristic.h"
+#include "MinisatHeuristic.h"
 #include "Solver.h"
 #include <string>
 
@@ -38,6 +39,8 @@ class CombinedHeuristic : public Heuristic
         void onFinishedParsing( );
         unsigned int getTreshold( );
         void onFinishedSolving( ) { };
+        void subscribeAtoms( AtomDispatcher& dispatcher );
+        void onRestart( );
 
         void addHeuristic( Heuristic* h );
         bool addHeuristic( string h );
@@ -46,12 +49,28 @@ class CombinedHeuristic : public Heuristic
         Literal makeAChoiceProtected( );
 
     private:
+        // the arm in use: a domain heuristic, or minisat if index == heuristics.size( )
         unsigned int index;
 
-        Heuristic* minisat;
+        MinisatHeuristic* minisat;
         vector< Heuristic* > heuristics;
 
-        double getTresholdStatistics( );
+        // for each arm, the number of restarts it was used for and the sum of its rewards
+        vector< unsigned int > plays;
+        vector< double > rewards;
+        unsigned int totalPlays;
+
+        // the choices, the conflicts when it started and the largest trail of the current restart
+        unsigned int choices;
+        uint64_t conflicts;
+        unsigned int maxAssigned;
+
+        // the domain heuristics only seed minisat, which is the only arm
+        bool seeding;
+
+        void seedMinisat( );
+        double getReward( ) const;
+        unsigned int selectArm( ) const;
 };
 
 #endif
@@ -91,7 +91,7 @@ Component::getClauseToPropagate(
                 assert( c->getAt( 0 ) == Literal( variable, FALSE ) );
                 assert( solver.getDecisionLevel( variable ) == solver.getCurrentDecisionLevel() );
 
-                c = new Clause( clauseToPropagate->size() );
+                c = Clause::create( clauseToPropagate->size() );
                 c->copyLiterals( *clauseToPropagate );
                 if( solver.glucoseHeuristic() )
                     c->setLbd( clauseToPropagate->lbd() );
@@ -548,7 +548,7 @@ Component::inferFalsityOfUnfoundedAtoms()
         if( solver.isFalse( variable ) )
             continue;        
 
-        Clause* loopFormulaPointer = new Clause();
+        Clause* loopFormulaPointer = Clause::create();
         Clause& loopFormula = *loopFormulaPointer;
         loopFormula.copyLiterals( *clauseToPropagate );
         if( solver.glucoseHeuristic() )
@@ -0,0 +1,105 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef EMARESTART_H
+#define EMARESTART_H
+
+#include <cstdint>
+
+#include "Restart.h"
+
+/*
+ * Glucose-like dynamic restarts where the averages are exponential moving
+ * averages instead of bounded queues: restart when the fast average of the
+ * LBDs exceeds the slow one by a margin. As in glucose, restarts are
+ * postponed when the trail is much longer than its average.
+ */
+class EmaRestart : public Restart
+{
+    public:
+        inline EmaRestart();
+
+        inline void onConflict( unsigned int trailSize );
+        void onLearnedClause( unsigned int lbd ) { fastLBD.update( lbd ); slowLBD.update( lbd ); }
+        inline bool hasToRestart();
+        void onRestart() { conflictsAfterRestart = 0; }
+        Restart* clone() const { return new EmaRestart(); }
+
+    private:
+        /*
+         * Exponential moving average with bias correction, so that the first
+         * values are not dominated by the initial value 0.
+         */
+        class Ema
+        {
+            public:
+                Ema( double a ) : value( 0.0 ), biased( 0.0 ), exponent( 1.0 ), alpha( a ) {}
+
+                void update( double x )
+                {
+                    biased += alpha * ( x - biased );
+                    exponent *= 1.0 - alpha;
+                    value = biased / ( 1.0 - exponent );
+                }
+
+                double get() const { return value; }
+
+            private:
+                double value;
+                double biased;
+                double exponent;
+                double alpha;
+        };
+
+        Ema fastLBD;
+        Ema slowLBD;
+        Ema trail;
+
+        double margin;
+        double R;
+        unsigned int minimumConflicts;
+        unsigned int blockingConflicts;
+
+        uint64_t conflicts;
+        uint64_t conflictsAfterRestart;
+        uint64_t blockedUntil;
+};
+
+EmaRestart::EmaRestart() : fastLBD( 1.0 / 32 ), slowLBD( 1.0 / 16384 ), trail( 1.0 / 4096 ), margin( 1.25 ), R( 1.4 ),
+    minimumConflicts( 2 ), blockingConflicts( 50 ), conflicts( 0 ), conflictsAfterRestart( 0 ), blockedUntil( 0 )
+{
+}
+
+void
+EmaRestart::onConflict(
+    unsigned int trailSize )
+{
+    conflicts++;
+    conflictsAfterRestart++;
+    if( conflicts > 10000 && trailSize > R * trail.get() )
+        blockedUntil = conflicts + blockingConflicts;
+    trail.update( trailSize );
+}
+
+bool
+EmaRestart::hasToRestart()
+{
+    return conflictsAfterRestart >= minimumConflicts && conflicts >= blockedUntil && fastLBD.get() > margin * slowLBD.get();
+}
+
+#endif
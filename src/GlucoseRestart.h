@@ -0,0 +1,79 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef GLUCOSERESTART_H
+#define GLUCOSERESTART_H
+
+#include <cstdint>
+
+#include "Restart.h"
+#include "stl/BoundedQueue.h"
+
+/*
+ * Dynamic restarts of glucose: restart when the average LBD of the last
+ * learned clauses is high with respect to the global average. A restart is
+ * blocked when the trail is much longer than the average of the last
+ * conflicts, since the solver is probably approaching a model.
+ */
+class GlucoseRestart : public Restart
+{
+    public:
+        inline GlucoseRestart();
+
+        inline void onConflict( unsigned int trailSize );
+        void onLearnedClause( unsigned int lbd ) { sumLBD += lbd; lbdQueue.push( lbd ); }
+        inline bool hasToRestart();
+        Restart* clone() const { return new GlucoseRestart(); }
+
+    private:
+        double K;
+        double R;
+        float sumLBD;
+        uint64_t conflicts;
+
+        bqueue< unsigned int > lbdQueue;
+        bqueue< unsigned int > trailQueue;
+};
+
+GlucoseRestart::GlucoseRestart() : K( 0.8 ), R( 1.4 ), sumLBD( 0.0 ), conflicts( 0 )
+{
+    lbdQueue.initSize( 50 );
+    trailQueue.initSize( 5000 );
+}
+
+void
+GlucoseRestart::onConflict(
+    unsigned int trailSize )
+{
+    conflicts++;
+    trailQueue.push( trailSize );
+    if( conflicts > 10000 && lbdQueue.isValid() && trailSize > R * trailQueue.getAvg() )
+        lbdQueue.fastClear();
+}
+
+bool
+GlucoseRestart::hasToRestart()
+{
+    if( !lbdQueue.isValid() || ( lbdQueue.getAvg() * K ) <= ( sumLBD / conflicts ) )
+        return false;
+
+    lbdQueue.fastClear();
+    return true;
+}
+
+#endif
@@ -182,7 +182,7 @@ HCComponent::iterationInternalLiterals(
     vector< Literal >& assumptions )
 {
     bool hasToAddClause = true;
-    Clause* clause = new Clause();    
+    Clause* clause = Clause::create();    
     for( unsigned int i = 0; i < hcVariables.size(); i++ )
     {
         Literal lit = Literal( hcVariables[ i ], NEGATIVE );
@@ -255,7 +255,7 @@ HCComponent::addClauseToChecker(
     assert( c != NULL );
     trace_msg( modelchecker, 2, "Adding clause " << *c );
     Clause& orig = *c;
-    Clause* clause = new Clause( c->size() );    
+    Clause* clause = Clause::create( c->size() );    
     for( unsigned int i = 0; i < orig.size(); i++ )
     {        
         clause->addLiteral( orig[ i ] );        
@@ -265,8 +265,10 @@ HCComponent::addClauseToChecker(
             Var newVar = getCheckerVarFromExternalLiteral( orig[ i ] );            
             if( newVar != v )
             {
-                orig[ i ].setVariable( newVar );
-                orig[ i ].setPositive();
+                Literal lit = orig[ i ];
+                lit.setVariable( newVar );
+                lit.setPositive();
+                orig.setAt( i, lit );
             }
         }
         else
@@ -276,8 +278,10 @@ HCComponent::addClauseToChecker(
                 Var newVar = getCheckerVarFromExternalLiteral( orig[ i ] );
                 if( newVar != v )
                 {
-                    orig[ i ].setVariable( newVar );
-                    orig[ i ].setPositive();
+                    Literal lit = orig[ i ];
+                    lit.setVariable( newVar );
+                    lit.setPositive();
+                    orig.setAt( i, lit );
                 }
             }
         }
@@ -390,7 +394,7 @@ HCComponent::addLearnedClausesFromChecker(
     assert( solver.exchangeClauses() );
     if( learnedClause->size() > 8 )
         return;        
-    Clause* c = new Clause( learnedClause->size() );
+    Clause* c = Clause::create( learnedClause->size() );
     for( unsigned int i = 0; i < learnedClause->size(); i++ )
     {
         Literal current = getGeneratorLiteralFromCheckerLiteral( learnedClause->getAt( i ) );
@@ -410,7 +414,7 @@ void
 HCComponent::createInitialClauseAndSimplifyHCVars()
 {
     trace_msg( modelchecker, 1, "Simplifying Head Cycle variables" );
-    Clause* clause = new Clause();
+    Clause* clause = Clause::create();
 
     bool satisfied = false;
     int j = 0;
@@ -31,7 +31,7 @@ Heuristic::makeAChoice()
     return makeAChoiceProtected();
 }
 
-void
+bool
 Heuristic::addClause(
 	vector< Literal > literals
 )
@@ -39,10 +39,20 @@ Heuristic::addClause(
 	if ( solver.getCurrentDecisionLevel( ) != 0 )
 		solver.unrollToZero( );
 
-	Clause* clause = new Clause( literals.size( ) );
+	Clause* clause = Clause::create( literals.size( ) );
 
 	for ( Literal l : literals )
 		clause->addLiteral( l );
 
-	solver.addClauseRuntime( clause );
+	bool result = solver.addClauseRuntime( clause );
+	solver.notifyAssigned( );
+	return result;
+}
+
+void
+Heuristic::setPhase(
+	Literal lit
+)
+{
+	solver.setInitialPhase( lit );
 }
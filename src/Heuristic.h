@@ -21,15 +21,18 @@
 
 #include "util/Assert.h"
 #include "Literal.h"
+#include "SolverListener.h"
 #include <vector>
 using namespace std;
 
 class Solver;
+class Atom;
+class AtomDispatcher;
 
-class Heuristic
+class Heuristic : public SolverListener
 {
     public:
-        inline Heuristic( Solver& s ) : solver( s ){}
+        inline Heuristic( Solver& s ) : solver( s ), incoherent( false ){}
         virtual ~Heuristic(){};
 
         Literal makeAChoice();
@@ -43,17 +46,43 @@ class Heuristic
         virtual void conflictOccurred() = 0;
         virtual unsigned int getTreshold( ) = 0;
         virtual void onFinishedSolving() = 0;
+
+        /**
+         * Subscribes the heuristic to the signatures of the atoms it reads; it is
+         * called once, before onFinishedParsing.
+         */
+        virtual void subscribeAtoms( AtomDispatcher& ) {}
+
+        /**
+         * An atom of the input with a signature subscribed by the heuristic.
+         */
+        virtual void onAtom( const Atom& ) {}
+
+        /**
+         * Appends the literals the heuristic would choose, most preferred first; they
+         * seed the activities and the phases of minisat with --heuristic-seeding.
+         */
+        virtual void getPreferredLiterals( vector< Literal >& ) {}
+
         inline void addPreferredChoice( Literal lit ){ assert( lit != Literal::null ); preferredChoices.push_back( lit ); }
         inline void removePrefChoices() { preferredChoices.clear(); }
 
+        /**
+         * True if the heuristic has proved that there are no answer sets.
+         */
+        inline bool isIncoherent() const { return incoherent; }
+
     protected:
         virtual Literal makeAChoiceProtected() = 0;
-        void addClause( vector< Literal > literals );
+        bool addClause( vector< Literal > literals );
+        void setPhase( Literal lit );
+        inline void setIncoherent() { incoherent = true; }
 
         Solver& solver;
 
     private:
         vector< Literal > preferredChoices;
+        bool incoherent;
 };
 
 #endif
@@ -0,0 +1,70 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "HeuristicRegistry.h"
+
+#include <algorithm>
+
+#include "util/HeuristicUtil.h"
+
+bool
+HeuristicRegistry::add(
+    string name,
+    Factory factory )
+{
+    toLower( name );
+    getFactories()[ name ] = factory;
+    return true;
+}
+
+Heuristic*
+HeuristicRegistry::create(
+    string name,
+    Solver& solver )
+{
+    toLower( name );
+    map< string, Factory >::const_iterator it = getFactories().find( name );
+    return it == getFactories().end() ? NULL : it->second( solver );
+}
+
+string
+HeuristicRegistry::getNames()
+{
+    string names;
+    for( map< string, Factory >::const_iterator it = getFactories().begin(); it != getFactories().end(); ++it )
+        names += ( names.empty() ? "" : ", " ) + it->first;
+    return names;
+}
+
+/*
+ * the factories are created on first use, since the heuristics register themselves
+ * during static initialization
+ */
+map< string, HeuristicRegistry::Factory >&
+HeuristicRegistry::getFactories()
+{
+    static map< string, Factory > factories;
+    return factories;
+}
+
+void
+HeuristicRegistry::toLower(
+    string& name )
+{
+    transform( name.begin(), name.end(), name.begin(), HeuristicUtil::tolower );
+}
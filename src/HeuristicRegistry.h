@@ -0,0 +1,64 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef HEURISTICREGISTRY_H
+#define HEURISTICREGISTRY_H
+
+#include <map>
+#include <string>
+
+using namespace std;
+
+class Heuristic;
+class Solver;
+
+/*
+ * Factories of the domain heuristics, by name. A heuristic registers itself in its
+ * translation unit with REGISTER_HEURISTIC, and is then available by name to the
+ * command line options (for instance --heuristic-combined) without further wiring.
+ */
+class HeuristicRegistry
+{
+    public:
+        typedef Heuristic* ( *Factory )( Solver& solver );
+
+        /**
+         * Registers the factory under the given name (case insensitive), returns true.
+         */
+        static bool add( string name, Factory factory );
+
+        /**
+         * A new heuristic with the given name (case insensitive), NULL if there is none.
+         */
+        static Heuristic* create( string name, Solver& solver );
+
+        /**
+         * The registered names, separated by commas.
+         */
+        static string getNames();
+
+    private:
+        static map< string, Factory >& getFactories();
+        static void toLower( string& name );
+};
+
+#define REGISTER_HEURISTIC( name, type ) \
+    static const bool type##Registered __attribute__(( unused )) = \
+        HeuristicRegistry::add( name, []( Solver& s ) -> Heuristic* { return new type( s ); } )
+
+#endif
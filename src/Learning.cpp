@@ -118,7 +118,10 @@ Learning::onConflict(
             bool hasToComputeMaxDecisionLevel = !solver.incremental() && solver.minimisationWithBinaryResolution( *learnedClause, lbd );
             assert( sameDecisionLevelOfSolver( learnedClause->getAt( 0 ) ) );
             if( learnedClause->size() == 1 )
+            {
+                learnedClause = learnedClause->shrinkToFit();
                 return learnedClause;
+            }
             
             if( hasToComputeMaxDecisionLevel )            
             {
@@ -147,6 +150,7 @@ Learning::onConflict(
     
     trace_msg( learning, 1, "Learned Clause: " << *learnedClause );    
     
+    learnedClause = learnedClause->shrinkToFit();
     return learnedClause;
 }
 
@@ -242,12 +246,18 @@ Learning::simplifyLearnedClause(
     
     trace_msg( learning, 1, "Simplifying learned clause " << *lc );
     
+    abstractLevels = 0;
+    for( unsigned int i = 0; i < learnedClause.size(); i++ )
+        abstractLevels |= abstractLevel( learnedClause.getAt( i ).getVariable() );
+    
     for( unsigned int i = 1; i < learnedClause.size(); )
     {
         trace_msg( learning, 5, "Considering literal " << learnedClause.getAt( i ) );
+        neededRecursion = false;
         if( allMarked( solver.getImplicant( learnedClause.getAt( i ).getVariable() ), learnedClause.getAt( i ) ) )
         {
             trace_msg( learning, 5, "Removing literal " << learnedClause.getAt( i ) );
+            statistics( &solver, onRemovedLiteral( neededRecursion ) );
             learnedClause.swapLiteralsNoWatches( i, learnedClause.size() - 1 );
             learnedClause.removeLastLiteralNoWatches();
         }
@@ -258,9 +268,11 @@ Learning::simplifyLearnedClause(
         
     }
     
+    neededRecursion = false;
     if( allMarked( solver.getImplicant( learnedClause.getAt( 0 ).getVariable() ), learnedClause.getAt( 0 ) ) )
     {
         trace_msg( learning, 5, "Removing literal " << learnedClause.getAt( 0 ) );
+        statistics( &solver, onRemovedLiteral( neededRecursion ) );
         learnedClause.swapLiteralsNoWatches( 0, learnedClause.size() - 1 );
         learnedClause.removeLastLiteralNoWatches();
         maxDecisionLevel = 0;
@@ -337,24 +349,39 @@ bool
 Learning::onNavigatingLiteralForAllMarked(
     Literal literal )
 {
-    if( !isVisited( literal.getVariable(), numberOfCalls ) )
+    Var v = literal.getVariable();
+    if( isVisited( v, numberOfCalls ) )
     {
-        if( allMarked( solver.getImplicant( literal.getVariable() ), literal ) )
-        {
-            trace_msg( learning, 5, "Literal " << literal << " set as visited" );
-            setVisited( literal.getVariable(), numberOfCalls );
-        }
-        else
-        {
-            return false;
-        }
+        trace_msg( learning, 5, "Literal " << literal << " has been visited." );
+        return true;
     }
-    else
+    
+    if( notRemovable[ v ] == numberOfCalls || solver.isUndefined( v ) )
+        return false;
+    
+    if( solver.getDecisionLevel( v ) == 0 )
     {
-        trace_msg( learning, 5, "Literal " << literal << " has been visited." );
+        trace_msg( learning, 5, "Literal " << literal << " has been inferred at level 0" );
+        return true;
     }
     
-    return true;
+    if( ( abstractLevel( v ) & abstractLevels ) != 0 && allMarked( solver.getImplicant( v ), literal ) )
+    {
+        trace_msg( learning, 5, "Literal " << literal << " set as visited" );
+        setVisited( v, numberOfCalls );
+        neededRecursion = true;
+        return true;
+    }
+    
+    notRemovable[ v ] = numberOfCalls;
+    return false;
+}
+
+unsigned int
+Learning::abstractLevel(
+    Var v ) const
+{
+    return 1u << ( solver.getDecisionLevel( v ) & 31 );
 }
 
 void
@@ -363,6 +390,7 @@ Learning::resetVariablesNumberOfCalls()
     for( unsigned i = 1; i < visited.size(); ++i )
     {
         setVisited( i, 0 );
+        notRemovable[ i ] = 0;
     }
 }
 
@@ -397,6 +425,7 @@ Learning::learnClausesFromUnfoundedSet(
         learnedClause->swapLiterals( 0, maxPosition );
     
     trace_msg( learning, 1, "Reason for loop formula: " << *learnedClause );
+    learnedClause = learnedClause->shrinkToFit();
     return learnedClause;
 }
 
@@ -447,6 +476,7 @@ Learning::learnClausesFromDisjunctiveUnfoundedSet(
         learnedClause->setLbd( solver.computeLBD( *learnedClause ) );
         
     trace_msg( learning, 1, "Reason for disjunctive loop formula: " << *learnedClause );
+    learnedClause = learnedClause->shrinkToFit();
     return learnedClause;
 }
 
@@ -577,6 +607,7 @@ Learning::analyzeFinal(
     if( solver.getCurrentDecisionLevel() == 0 )
     {
         trace_msg( weakconstraints, 2, "Conflict at level 0. Unsat core " << *learnedClause );
+        learnedClause = learnedClause->shrinkToFit();
         return learnedClause;
     }
 
@@ -619,5 +650,6 @@ Learning::analyzeFinal(
     }
     
     trace_msg( weakconstraints, 2, "Unsat core " << *learnedClause );
+    learnedClause = learnedClause->shrinkToFit();
     return learnedClause;
 }
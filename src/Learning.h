@@ -95,6 +95,31 @@ class Learning
         void simplifyLearnedClause( Clause* lc );
         bool allMarked( Reason* clause, Literal literal );
         
+        /**
+         * The abstraction of the decision level of a variable, i.e. a bit
+         * among 32 selected by the decision level.
+         */
+        inline unsigned int abstractLevel( Var v ) const;
+        
+        /**
+         * The union of the abstract levels of the literals in the learned clause.
+         * A literal whose abstract level is not included cannot be implied by
+         * the literals of the learned clause, so its implicant is not navigated.
+         */
+        unsigned int abstractLevels;
+        
+        /**
+         * Variables which are known not to be implied by the learned clause
+         * in the current call, so that they are not navigated twice.
+         */
+        vector< unsigned int > notRemovable;
+        
+        /**
+         * Set when the literal being checked is removable only by navigating
+         * the implicant of another literal.
+         */
+        bool neededRecursion;
+        
         void computeMaxDecisionLevel( const Clause& lc );
         
         void sortClause( Clause* clause );
@@ -121,9 +146,10 @@ class Learning
         Vector< Var > lastDecisionLevel;
 };
 
-Learning::Learning( Solver& s ) : solver( s ), decisionLevel( 0 ), learnedClause( NULL ), pendingVisitedVariables( 0 ), numberOfCalls( 0 ), maxDecisionLevel( 0 ), maxPosition( 0 )
+Learning::Learning( Solver& s ) : solver( s ), decisionLevel( 0 ), learnedClause( NULL ), abstractLevels( 0 ), neededRecursion( false ), pendingVisitedVariables( 0 ), numberOfCalls( 0 ), maxDecisionLevel( 0 ), maxPosition( 0 )
 {
     visited.push_back( 0 );
+    notRemovable.push_back( 0 );
 }
 
 Learning::~Learning()
@@ -147,6 +173,7 @@ void
 Learning::onNewVariable()
 {
     visited.push_back( 0 );
+    notRemovable.push_back( 0 );
 }
 
 #endif
@@ -36,8 +36,6 @@ class Literal
 
         inline explicit Literal( Var v = 0, unsigned int sign = POSITIVE );
         
-        inline ~Literal();
-
         inline int getId() const;
         inline unsigned int getIndex() const { return ( variable << 1 ) | sign; }
 
@@ -102,10 +100,6 @@ Literal::Literal(
     assert( getVariable() == v );
 }
 
-Literal::~Literal()
-{
-}
-
 bool
 Literal::isPositive() const
 {
@@ -45,11 +45,7 @@ MinisatHeuristic::makeAChoiceProtected()
     assert_msg( solver.isUndefined( chosenVariable ), "The literal must be undefined" );
     trace_msg( heuristic, 1, "Ending MiniSAT heuristic" );
 
-    //FIXME: Maybe in future we want to add the right minisat policy    
-    if( solver.getCachedTruthValue( chosenVariable ) != UNDEFINED )
-        return solver.getCachedTruthValue( chosenVariable ) == TRUE ? Literal( chosenVariable, POSITIVE ) : Literal( chosenVariable, NEGATIVE );
-        
-    return Literal( chosenVariable, NEGATIVE );
+    return solver.getChoiceLiteral( chosenVariable );
 }
 
 // Returns a random float 0 <= x < 1. Seed must never be 0.
@@ -95,3 +91,29 @@ MinisatHeuristic::simplifyVariablesAtLevelZero()
         }
     }
 }
+
+void
+MinisatHeuristic::seedActivities(
+    const vector< Literal >& literals )
+{
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        Var v = literals[ i ].getVariable();
+        if( act[ v ] != 0.0 )
+            continue;
+
+        act[ v ] = variableIncrement * ( literals.size() - i ) / ( literals.size() + 1 );
+        // the heap holds only the variables unrolled so far, if any
+        if( heap.inHeap( v ) )
+            heap.decrease( v );
+        trace_msg( heuristic, 2, "Seeded activity of variable " << v << ": " << act[ v ] );
+    }
+}
+
+void
+MinisatHeuristic::refillHeap()
+{
+    for( unsigned int i = 0; i < vars.size(); i++ )
+        if( solver.isUndefined( vars[ i ] ) )
+            heap.push( vars[ i ] );
+}
@@ -54,6 +54,18 @@ class MinisatHeuristic : public Heuristic
         unsigned int getTreshold( ){ return 0; };
         void onFinishedSolving( ) { };
         
+        /**
+         * Pushes in the heap all the undefined variables. It is used when
+         * the unrolled variables have not been notified to this heuristic.
+         */
+        void refillHeap();
+        
+        /**
+         * Seeds the activities of the variables of the given literals, most preferred
+         * first. The seeds stay below a single bump, so the conflicts take over.
+         */
+        void seedActivities( const vector< Literal >& literals );
+        
     protected:
         virtual Literal makeAChoiceProtected();
         
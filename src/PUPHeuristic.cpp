@@ -19,150 +19,170 @@
 #include "PUPHeuristic.h"
 
 #include <algorithm>
+#include <climits>
 #include <iterator>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "AtomDispatcher.h"
+#include "HeuristicRegistry.h"
 #include "Solver.h"
 #include "util/Assert.h"
 #include "util/Constants.h"
-#include "util/VariableNames.h"
-#include "util/HeuristicUtil.h"
+
+REGISTER_HEURISTIC( "pup", PUPHeuristic );
 
 PUPHeuristic::PUPHeuristic( Solver& s ) :
-    Heuristic( s ),  startAt( 0 ), index( 0 ), maxPu( 2 ), maxElementsOnPu( 2 ), numberOfConflicts( 0 ), isConsitent( true ), conflictOccured( false ),
+    Heuristic( s ),  startAt( 0 ), numberOfStarts( wasp::Options::pupOrders ), index( 0 ), maxPu( 2 ), maxElementsOnPu( 2 ), numberOfConflicts( 0 ), isConsitent( true ), conflictOccured( false ),
 	conflictHandled( true ), assignedSinceConflict( 0 ), redoAfterConflict( false ),
-	sNumberOfConflicts( 0 ), sNumberOfBacktracks( 0 ), sNumberOfOrdersCreated( 0 ), sNumberOfRecommendations( 0 ), sNumberOfOrderMaxReached( 0 )
+	sNumberOfConflicts( 0 ), sNumberOfBacktracks( 0 ), sNumberOfOrdersCreated( 0 ), sNumberOfRecommendations( 0 ), sNumberOfOrderMaxReached( 0 ),
+	zoneSignature( UINT_MAX ), doorSensorSignature( UINT_MAX ), zone2sensorSignature( UINT_MAX ), comUnitSignature( UINT_MAX ), unit2zoneSignature( UINT_MAX ),
+	unit2sensorSignature( UINT_MAX ), maxElementsSignature( UINT_MAX ), maxPUSignature( UINT_MAX ), partnerunitsSignature( UINT_MAX )
 { }
 
 /*
- * Processes all variables related to the PUP
+ * returns the id of the node named by the given argument of the atom among the zones or
+ * the sensors ( a new id if the node is new )
+ *
+ * @param ids		the ids of the zones or of the sensors
+ * @param atom		the atom
+ * @param argument	the argument naming the node
+ * @param type		ZONE or SENSOR
+ */
+unsigned int
+PUPHeuristic::getNodeId(
+	unordered_map < unsigned int, unsigned int >& ids,
+	const Atom& atom,
+	unsigned int argument,
+	unsigned int type )
+{
+	unordered_map < unsigned int, unsigned int >::iterator it = ids.find( atom.getArgument( argument ) );
+	if ( it != ids.end( ) )
+		return it->second;
+
+	unsigned int id = nodeNames.size( );
+	ids[ atom.getArgument( argument ) ] = id;
+	nodeNames.push_back( atom.getArgumentName( argument ) );
+	nodeTypes.push_back( type );
+	return id;
+}
+
+/*
+ * returns the id of the partner unit named by the given argument of the atom ( a new id if the unit is new )
+ */
+unsigned int
+PUPHeuristic::getUnitId(
+	const Atom& atom,
+	unsigned int argument )
+{
+	unordered_map < unsigned int, unsigned int >::iterator it = unitIds.find( atom.getArgument( argument ) );
+	if ( it != unitIds.end( ) )
+		return it->second;
+
+	unsigned int id = unitNames.size( );
+	unitIds[ atom.getArgument( argument ) ] = id;
+	unitNames.push_back( atom.getArgumentName( argument ) );
+	return id;
+}
+
+void
+PUPHeuristic::subscribeAtoms(
+	AtomDispatcher& dispatcher )
+{
+	zoneSignature = dispatcher.subscribe( this, "zone", 1 );
+	doorSensorSignature = dispatcher.subscribe( this, "doorSensor", 1 );
+	zone2sensorSignature = dispatcher.subscribe( this, "zone2sensor", 2 );
+	comUnitSignature = dispatcher.subscribe( this, "comUnit", 1 );
+	unit2zoneSignature = dispatcher.subscribe( this, "unit2zone", 2 );
+	unit2sensorSignature = dispatcher.subscribe( this, "unit2sensor", 2 );
+	maxElementsSignature = dispatcher.subscribe( this, "maxElements", 1 );
+	maxPUSignature = dispatcher.subscribe( this, "maxPU", 1 );
+	partnerunitsSignature = dispatcher.subscribe( this, "partnerunits", 2 );
+}
+
+/*
+ * Processes all atoms related to the PUP
  * 		read zones, sensors, partner units and all unit2zone/unit2sensors
  * 		and put them in to the corresponding vectors
  *
- * 	@param v	the variable to process
+ * 	@param atom	the atom to process
  */
 void
-PUPHeuristic::processVariable (
-    Var v )
+PUPHeuristic::onAtom (
+    const Atom& atom )
 {
-	string name = VariableNames::getName( v );
+	Var v = atom.getVariable( );
 
-	name.erase(std::remove(name.begin(),name.end(),' '),name.end());
-
-	string tmp;
-	string tmp2;
-
-	if( name.compare( 0, 5, "zone(" ) == 0 )
+	if( atom.getSignature( ) == zoneSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
-
-		Node zone;
-		zone.name = tmp;
-		zone.var = v;
-		zone.considered = 0;
-		zone.type = ZONE;
+		zones.push_back( getZoneId( atom, 0 ) );
 
-		zones.push_back( zone );
-
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( zone )" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( zone )" );
 	}
-	else if( name.compare( 0, 11, "doorSensor(" ) == 0 )
+	else if( atom.getSignature( ) == doorSensorSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
-
-		Node sensor;
-		sensor.name = tmp;
-		sensor.var = v;
-		sensor.considered = 0;
-		sensor.type = SENSOR;
+		sensors.push_back( getSensorId( atom, 0 ) );
 
-		sensors.push_back( sensor );
-
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( sensor )" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( sensor )" );
 	}
-	else if( name.compare( 0, 12, "zone2sensor(" ) == 0 )
+	else if( atom.getSignature( ) == zone2sensorSignature )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
-
-		Connection c;
-		c.from = tmp;
-		c.to = tmp2;
-		c.var = v;
+		Relation c;
+		c.first = getZoneId( atom, 0 );
+		c.second = getSensorId( atom, 1 );
+		c.variable = v;
 
 		zone2sensor.push_back( c );
 
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( zone2sensor )" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( zone2sensor )" );
 	}
-	else if( name.compare( 0, 8, "comUnit(" ) == 0 )
+	else if( atom.getSignature( ) == comUnitSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
-
-		Pu pu;
-		pu.name = tmp;
-		pu.var = v;
-
-		pu.numberOfPartners = 0;
-		pu.numberOfZones = 0;
-		pu.numberOfSensors = 0;
-		pu.removed = false;
+		partnerUnits.push_back( getUnitId( atom, 0 ) );
 
-		partnerUnits.push_back( pu );
-
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( partnerunit )" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( partnerunit )" );
 	}
-	else if( name.compare( 0, 10, "unit2zone(" ) == 0 )
+	else if( atom.getSignature( ) == unit2zoneSignature )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
-
-		ZoneAssignment za;
-		za.pu = tmp;
-		za.to = tmp2;
-		za.positive = v;
-		za.type = ZONE;
+		Relation za;
+		za.first = getUnitId( atom, 0 );
+		za.second = getZoneId( atom, 1 );
+		za.variable = v;
 
-		initUnitAssignments( za, U2Z );
+		unit2zone.push_back( za );
 
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( unit2zone )" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( unit2zone )" );
 	}
-	else if( name.compare( 0, 12, "unit2sensor(" ) == 0 )
+	else if( atom.getSignature( ) == unit2sensorSignature )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
+		Relation za;
+		za.first = getUnitId( atom, 0 );
+		za.second = getSensorId( atom, 1 );
+		za.variable = v;
 
-		ZoneAssignment za;
-		za.pu = tmp;
-		za.to = tmp2;
-		za.positive = v;
-		za.type = SENSOR;
+		unit2sensor.push_back( za );
 
-		initUnitAssignments( za, U2S );
-
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( unit2sensor )" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( unit2sensor )" );
 	}
-	else if( name.compare( 0, 12, "maxElements(" ) == 0 )
+	else if( atom.getSignature( ) == maxElementsSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
-
-		maxElementsOnPu = strtoul( tmp.c_str(), NULL, 0 );
+		maxElementsOnPu = atom.getNumber( 0 );
 
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( maxElements )" << " with max. " << maxElementsOnPu << " elements on a PU");
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( maxElements )" << " with max. " << maxElementsOnPu << " elements on a PU");
 	}
-	else if( name.compare( 0, 6, "maxPU(" ) == 0 )
+	else if( atom.getSignature( ) == maxPUSignature )
 	{
-		HeuristicUtil::getName( name, &tmp );
+		maxPu = atom.getNumber( 0 );
 
-		maxPu = strtoul( tmp.c_str(), NULL, 0 );
-
-		trace_msg( heuristic, 3, "Processed variable " << v << " " << name << " ( maxPu )" << " with max. " << maxPu << " partners on a PU" );
+		trace_msg( heuristic, 3, "Processed variable " << v << " ( maxPu )" << " with max. " << maxPu << " partners on a PU" );
 	}
-	else if( name.compare( 0, 13, "partnerunits(" ) == 0 )
+	else if( atom.getSignature( ) == partnerunitsSignature )
 	{
-		HeuristicUtil::getName( name, &tmp, &tmp2 );
-
-		PartnerUnitConnection puc;
+		Relation puc;
+		puc.first = getUnitId( atom, 0 );
+		puc.second = getUnitId( atom, 1 );
 		puc.variable = v;
-		puc.unit1 = tmp;
-		puc.unit2 = tmp2;
 
 		partnerUnitConnections.push_back( puc );
 	}
@@ -177,15 +197,10 @@ PUPHeuristic::onFinishedParsing (
 	)
 {
 	trace_msg( heuristic, 1, "Initializing QuickPuP heuristic" );
-	trace_msg( heuristic, 2, "Start processing variables" );
-
-	for ( Var variable : variables )
-	{
-		if ( !VariableNames::isHidden( variable ) )
-			processVariable( variable );
-	}
 
 	initRelation( );
+	initUnitAssignments( );
+	subscribeAssignments( );
 
 	if ( zones.size( ) > ( partnerUnits.size( ) * maxElementsOnPu ) || sensors.size( ) > ( partnerUnits.size( ) * maxElementsOnPu ) )
 		isConsitent = false;
@@ -196,160 +211,205 @@ PUPHeuristic::onFinishedParsing (
 }
 
 /*
- * initialize the connection between zones and sensors
+ * subscribes to the assignment variables, whose truth values are then followed through
+ * onAssigned and onUnassigned instead of being checked at each choice
  */
 void
-PUPHeuristic::initRelation(
+PUPHeuristic::subscribeAssignments(
 	)
 {
-	Node *z;
-	Node *s;
-	bool found;
+	cellTrue.assign( assignmentVariables.size( ), false );
+	variableCell.assign( solver.numberOfVariables( ) + 1, UINT_MAX );
+	unitUsage.assign( unitNames.size( ), 0 );
+	nodeUsage.assign( nodeNames.size( ), 0 );
 
-	trace_msg( heuristic, 2, "Creating zone-to-sensor relation" );
-
-	for ( Connection c : zone2sensor)
+	for ( unsigned int cell = 0; cell < assignmentVariables.size( ); cell++ )
 	{
-		found = false;
-		for ( unsigned int i = 0; i < zones.size() && !found; i++ )
+		if ( assignmentVariables[ cell ] != 0 )
 		{
-			if ( c.from == zones[ i ].name )
-			{
-				z = &zones[ i ];
-				found = true;
-			}
+			variableCell[ assignmentVariables[ cell ] ] = cell;
+			solver.subscribe( this, assignmentVariables[ cell ] );
 		}
-
-		found = false;
-		for ( unsigned int i = 0; i < sensors.size() && !found; i++ )
-		{
-			if ( c.to == sensors[ i ].name )
-			{
-				s = &sensors[ i ];
-				found = true;
-			}
-		}
-
-		z->children.push_back( s );
-		s->children.push_back( z );
 	}
+}
 
-	trace_msg( heuristic, 2, "Creating 'usedIn' relation" );
-
-	ZoneAssignment* za;
-	for ( unsigned int i = 0; i < unit2zone.size( ); i++ )
+void
+PUPHeuristic::onAssigned(
+	const vector< Literal >& literals )
+{
+	for ( Literal literal : literals )
 	{
-		za = &unit2zone[ i ];
+		if ( !literal.isPositive( ) )
+			continue;
 
-		found = false;
-		for ( unsigned int j = 0; j < zones.size( ) && !found; j++ )
-		{
-			if ( zones[ j ].name == za->to )
-			{
-				zones[ j ].usedIn.push_back( za );
-				found = true;
-			}
-		}
-
-		found = false;
-		for ( unsigned int j = 0; j < partnerUnits.size( ) && !found; j++)
-		{
-			if ( partnerUnits[ j ].name == za->pu )
-			{
-				partnerUnits[ j ].usedIn.push_back( za );
-				found = true;
-			}
-		}
+		unsigned int cell = variableCell[ literal.getVariable( ) ];
+		cellTrue[ cell ] = true;
+		unitUsage[ cell / nodeNames.size( ) ]++;
+		nodeUsage[ cell % nodeNames.size( ) ]++;
 	}
+}
 
-	for ( unsigned int i = 0; i < unit2sensor.size( ); i++ )
+void
+PUPHeuristic::onUnassigned(
+	const vector< Var >& variables )
+{
+	for ( Var variable : variables )
 	{
-		za = &unit2sensor[ i ];
+		unsigned int cell = variableCell[ variable ];
+		if ( !cellTrue[ cell ] )
+			continue;
 
-		found = false;
-		for ( unsigned int j = 0; j < sensors.size( ) && !found; j++ )
-		{
-			if ( sensors[ j ].name == za->to )
-			{
-				sensors[ j ].usedIn.push_back( za );
-				found = true;
-			}
-		}
+		cellTrue[ cell ] = false;
+		unitUsage[ cell / nodeNames.size( ) ]--;
+		nodeUsage[ cell % nodeNames.size( ) ]--;
+	}
+}
 
-		found = false;
-		for ( unsigned int j = 0; j < partnerUnits.size( ) && !found; j++)
+/*
+ * one assignment for each node of the current order: the first partner unit, in input
+ * order, that still has room for a node of its type when the nodes before it are placed
+ * the same way ( nothing if there is no order )
+ */
+void
+PUPHeuristic::getPreferredLiterals(
+	vector< Literal >& literals )
+{
+	if ( !isConsitent )
+		return;
+
+	vector < unsigned int > zonesOnUnit( unitNames.size( ), 0 );
+	vector < unsigned int > sensorsOnUnit( unitNames.size( ), 0 );
+	for ( unsigned int node : order )
+	{
+		vector < unsigned int >& elementsOnUnit = nodeTypes[ node ] == ZONE ? zonesOnUnit : sensorsOnUnit;
+		for ( unsigned int unit : partnerUnits )
 		{
-			if ( partnerUnits[ j ].name == za->pu )
+			Var variable = getVariable( unit, node );
+			if ( variable != 0 && elementsOnUnit[ unit ] < maxElementsOnPu )
 			{
-				partnerUnits[ j ].usedIn.push_back( za );
-				found = true;
+				literals.push_back( Literal( variable, POSITIVE ) );
+				elementsOnUnit[ unit ]++;
+				break;
 			}
 		}
 	}
 }
 
 /*
- * reset heuristic
- * 		( in case of creating a new order )
+ * initialize the connection between zones and sensors
  */
-bool
-PUPHeuristic::resetHeuristic (
+void
+PUPHeuristic::initRelation(
 	)
 {
-	assignments.clear( );
-	index = 0;
+	trace_msg( heuristic, 2, "Creating zone-to-sensor relation" );
 
-	solver.unrollToZero( );
-	solver.clearConflictStatus( );
+	childrenBegin.assign( nodeNames.size( ) + 1, 0 );
+	for ( const Relation& c : zone2sensor )
+	{
+		childrenBegin[ c.first + 1 ]++;
+		childrenBegin[ c.second + 1 ]++;
+	}
+	for ( unsigned int node = 0; node < nodeNames.size( ); node++ )
+		childrenBegin[ node + 1 ] += childrenBegin[ node ];
 
-	return createOrder( );
+	vector < unsigned int > position( childrenBegin.begin( ), childrenBegin.end( ) - 1 );
+	children.resize( childrenBegin.back( ) );
+	for ( const Relation& c : zone2sensor )
+	{
+		children[ position[ c.first ]++ ] = c.second;
+		children[ position[ c.second ]++ ] = c.first;
+	}
+
+	zone2sensor.clear( );
+
+	considered.assign( nodeNames.size( ), 0 );
+	order.reserve( nodeNames.size( ) );
+	assignments.reserve( nodeNames.size( ) );
 }
 
 /*
- * initialize zone assignments
- *
- * @param za	the zone assingment
- * @param sign	positive or negative atom
- * @param type 	sensor or zone
+ * initialize the unit assignments: the (unit, node) table and the assignments of each
+ * node and of each unit
+ * 		( the first atom of a unit and node fixes the position of the assignment, the last one its variable )
  */
 void
 PUPHeuristic::initUnitAssignments(
-	ZoneAssignment za,
-	unsigned int type )
+	)
 {
-	bool found = false;
-	unsigned int i;
+	trace_msg( heuristic, 2, "Creating 'usedIn' relation" );
+
+	assignmentVariables.assign( unitNames.size( ) * nodeNames.size( ), 0 );
+	tried.assign( assignmentVariables.size( ), false );
+	nodeAssignmentsBegin.assign( nodeNames.size( ) + 1, 0 );
+	unitAssignmentsBegin.assign( unitNames.size( ) + 1, 0 );
 
-	if ( type == U2Z )
+	for ( const vector < Relation >* relation : { &unit2zone, &unit2sensor } )
 	{
-		for ( i = 0; i < unit2zone.size( ) && !found; i++ )
+		for ( const Relation& za : *relation )
 		{
-			if ( unit2zone[ i ].pu == za.pu && unit2zone[ i ].to == za.to )
+			Var& variable = assignmentVariables[ za.first * nodeNames.size( ) + za.second ];
+			if ( variable == 0 )
 			{
-				unit2zone[ i ].positive = za.positive;
-				found = true;
+				nodeAssignmentsBegin[ za.second + 1 ]++;
+				unitAssignmentsBegin[ za.first + 1 ]++;
 			}
+			variable = za.variable;
 		}
 	}
-	else if ( type == U2S )
+	for ( unsigned int node = 0; node < nodeNames.size( ); node++ )
+		nodeAssignmentsBegin[ node + 1 ] += nodeAssignmentsBegin[ node ];
+	for ( unsigned int unit = 0; unit < unitNames.size( ); unit++ )
+		unitAssignmentsBegin[ unit + 1 ] += unitAssignmentsBegin[ unit ];
+
+	vector < unsigned int > nodePosition( nodeAssignmentsBegin.begin( ), nodeAssignmentsBegin.end( ) - 1 );
+	vector < unsigned int > unitPosition( unitAssignmentsBegin.begin( ), unitAssignmentsBegin.end( ) - 1 );
+	nodeAssignments.resize( nodeAssignmentsBegin.back( ) );
+	unitAssignments.resize( unitAssignmentsBegin.back( ) );
+
+	// tried marks the assignments already added and is cleared afterwards
+	for ( const vector < Relation >* relation : { &unit2zone, &unit2sensor } )
 	{
-		for ( i = 0; i < unit2sensor.size( ) && !found; i++ )
+		for ( const Relation& za : *relation )
 		{
-			if ( unit2sensor[ i ].pu == za.pu && unit2sensor[ i ].to == za.to )
-			{
-				unit2sensor[ i ].positive = za.positive;
-				found = true;
-			}
+			unsigned int cell = za.first * nodeNames.size( ) + za.second;
+			if ( tried[ cell ] )
+				continue;
+			tried[ cell ] = true;
+
+			UnitAssignment ua;
+			ua.unit = za.first;
+			ua.node = za.second;
+			ua.variable = assignmentVariables[ cell ];
+
+			nodeAssignments[ nodePosition[ za.second ]++ ] = ua;
+			unitAssignments[ unitPosition[ za.first ]++ ] = ua;
 		}
 	}
 
-	if ( !found )
-	{
-		if ( type == U2Z)
-			unit2zone.push_back( za );
-		else if ( type == U2S )
-			unit2sensor.push_back( za );
-	}
+	for ( const UnitAssignment& ua : nodeAssignments )
+		tried[ ua.unit * nodeNames.size( ) + ua.node ] = false;
+
+	unit2zone.clear( );
+	unit2sensor.clear( );
+}
+
+/*
+ * reset heuristic
+ * 		( in case of creating a new order )
+ */
+bool
+PUPHeuristic::resetHeuristic (
+	)
+{
+	while ( !assignments.empty( ) )
+		popAssignment( );
+	index = 0;
+
+	solver.unrollToZero( );
+	solver.clearConflictStatus( );
+
+	return createOrder( );
 }
 
 /*
@@ -361,6 +421,9 @@ PUPHeuristic::createOrder (
 {
 	trace_msg( heuristic, 2, "Creating order" );
 
+	if ( numberOfStarts > 1 )
+		return createScoredOrder( );
+
 	if ( startAt >= zones.size( ) )
 	{
 		trace_msg( heuristic, 1, "No more starting zones" );
@@ -369,139 +432,253 @@ PUPHeuristic::createOrder (
 
 	sNumberOfOrdersCreated++;
 
-	order.clear();
-	unsigned int maxSize = zones.size( ) + sensors.size( );
-	unsigned int nextNode = 1;
-	unsigned int newConsidered = startAt + 1;
+	if ( !buildOrder( zones[ startAt ], order, considered, startAt + 1 ) )
+		return false;
 
-	Node *next = &zones[ startAt ];
-	(*next).considered = newConsidered;
-	order.push_back( next );
+	startAt++;
 
-	string orderOutput = (*next).name + ", ";
+	trace_action( heuristic, 3,
+		string orderOutput;
+		for ( unsigned int node : order )
+			orderOutput += nodeNames[ node ] + ", ";
+		trace_msg( heuristic, 3, "Considering order " + orderOutput );
+	)
+
+	return true;
+}
 
-	while ( order.size( ) < maxSize )
+/*
+ * create new order from the best pending one, evaluating the next starting zones
+ * when there is none
+ */
+bool
+PUPHeuristic::createScoredOrder (
+	)
+{
+	while ( pendingOrders.empty( ) )
 	{
-		if ( (*next).children.size( ) > ( maxPu * maxElementsOnPu + maxElementsOnPu ) )
+		if ( startAt >= zones.size( ) )
 		{
-			trace_msg( heuristic, 1, (*next).name + " needs to more connections than available from partner units" );
+			trace_msg( heuristic, 1, "No more starting zones" );
 			return false;
 		}
 
-		for ( Node *child : (*next).children )
+		evaluateStarts( );
+	}
+
+	sNumberOfOrdersCreated++;
+
+	order.swap( pendingOrders.front( ).order );
+	trace_msg( heuristic, 3, "Considering order starting at " << nodeNames[ order[ 0 ] ] << " ( width " << pendingOrders.front( ).width << " )" );
+	pendingOrders.pop_front( );
+
+	return true;
+}
+
+/*
+ * builds the orders of the next starting zones on worker threads and queues the
+ * feasible ones by increasing width ( ties keep the order of the zones )
+ */
+void
+PUPHeuristic::evaluateStarts (
+	)
+{
+	unsigned int batch = min( numberOfStarts, ( unsigned int ) zones.size( ) - startAt );
+	unsigned int numberOfWorkers = min( batch, max( 1u, thread::hardware_concurrency( ) ) );
+	vector < ScoredOrder > candidates( batch );
+
+	trace_msg( heuristic, 2, "Evaluating " << batch << " starting zones on " << numberOfWorkers << " threads" );
+
+	// each worker has its own visited stamps and positions, the candidates are disjoint
+	auto evaluate = [ this, &candidates, batch, numberOfWorkers ]( unsigned int worker )
+	{
+		vector < unsigned int > visited( nodeNames.size( ), 0 );
+		vector < unsigned int > position( nodeNames.size( ), 0 );
+
+		for ( unsigned int i = worker; i < batch; i += numberOfWorkers )
+		{
+			ScoredOrder& candidate = candidates[ i ];
+			candidate.start = startAt + i;
+			candidate.width = buildOrder( zones[ candidate.start ], candidate.order, visited, i + 1 )
+							  ? getOrderWidth( candidate.order, visited, i + 1, position ) : UINT_MAX;
+		}
+	};
+
+	vector < thread > workers;
+	for ( unsigned int worker = 1; worker < numberOfWorkers; worker++ )
+		workers.push_back( thread( evaluate, worker ) );
+	evaluate( 0 );
+	for ( thread& worker : workers )
+		worker.join( );
+
+	startAt += batch;
+
+	trace_action( heuristic, 1,
+		for ( const ScoredOrder& candidate : candidates )
+			if ( candidate.width == UINT_MAX )
+				trace_msg( heuristic, 1, "No order from " + nodeNames[ zones[ candidate.start ] ] + ": some node needs more connections than available from partner units or not all zones/sensors are connected" );
+	)
+
+	stable_sort( candidates.begin( ), candidates.end( ), []( const ScoredOrder& a, const ScoredOrder& b ) { return a.width < b.width; } );
+	for ( ScoredOrder& candidate : candidates )
+	{
+		if ( candidate.width == UINT_MAX )
+			break;
+
+		pendingOrders.push_back( ScoredOrder( ) );
+		pendingOrders.back( ).start = candidate.start;
+		pendingOrders.back( ).width = candidate.width;
+		pendingOrders.back( ).order.swap( candidate.order );
+	}
+}
+
+/*
+ * builds the BFS order of the nodes from the given zone
+ * 		( safe to call concurrently with different nodeOrder and visited, hence it does not trace )
+ *
+ * @param start		the starting zone
+ * @param nodeOrder	the order ( out )
+ * @param visited	per node: the stamp of the last order it was added to
+ * @param stamp		the stamp of this order, greater than the ones in visited
+ * @return			false if some node has too many connections or not all nodes are connected
+ */
+bool
+PUPHeuristic::buildOrder (
+	unsigned int start,
+	vector < unsigned int >& nodeOrder,
+	vector < unsigned int >& visited,
+	unsigned int stamp ) const
+{
+	nodeOrder.clear();
+	unsigned int maxSize = zones.size( ) + sensors.size( );
+	unsigned int nextNode = 1;
+
+	unsigned int next = start;
+	visited[ next ] = stamp;
+	nodeOrder.push_back( next );
+
+	while ( nodeOrder.size( ) < maxSize )
+	{
+		if ( childrenBegin[ next + 1 ] - childrenBegin[ next ] > ( maxPu * maxElementsOnPu + maxElementsOnPu ) )
+			return false;
+
+		for ( unsigned int i = childrenBegin[ next ]; i < childrenBegin[ next + 1 ]; i++ )
 		{
-			if ( (*child).considered < newConsidered )
+			unsigned int child = children[ i ];
+			if ( visited[ child ] < stamp )
 			{
-				(*child).considered = newConsidered;
-				order.push_back( child );
-				orderOutput += (*child).name + ", ";
+				visited[ child ] = stamp;
+				nodeOrder.push_back( child );
 			}
 		}
 
-		if ( nextNode >= order.size( ) )
-		{
-			trace_msg( heuristic, 1, "Not all zones/sensors are connected" );
+		if ( nextNode >= nodeOrder.size( ) )
 			return false;
-		}
 
-		next = order[ nextNode ];
+		next = nodeOrder[ nextNode ];
 		nextNode++;
 	}
 
-	startAt++;
+	return true;
+}
 
-	trace_msg( heuristic, 3, "Considering order " + orderOutput );
+/*
+ * width of an order: the largest distance in the order between connected nodes
+ * 		( connected nodes far apart are likely to need partner units )
+ */
+unsigned int
+PUPHeuristic::getOrderWidth (
+	const vector < unsigned int >& nodeOrder,
+	const vector < unsigned int >& visited,
+	unsigned int stamp,
+	vector < unsigned int >& position ) const
+{
+	for ( unsigned int i = 0; i < nodeOrder.size( ); i++ )
+		position[ nodeOrder[ i ] ] = i;
 
-	return true;
+	unsigned int width = 0;
+	for ( unsigned int i = 0; i < nodeOrder.size( ); i++ )
+	{
+		unsigned int node = nodeOrder[ i ];
+		for ( unsigned int j = childrenBegin[ node ]; j < childrenBegin[ node + 1 ]; j++ )
+		{
+			unsigned int child = children[ j ];
+			if ( visited[ child ] == stamp && position[ child ] > i )
+				width = max( width, position[ child ] - i );
+		}
+	}
+
+	return width;
 }
 
 /*
  * adding variable to assignments
- * if some unit was already assign to the sensor/zone, add the variable to the tried ones
+ * if some unit was already assign to the sensor/zone, add the unit to the tried ones
  * or add a new assignment otherwise
  *
- * @param var	the variable ( unit2zone or unit2sensor )
- * @param pu	the pu ( from unit2zone or unit2sensor )
+ * @param variable	the variable ( unit2zone or unit2sensor )
+ * @param unit		the unit ( from unit2zone or unit2sensor )
  */
-bool
-PUPHeuristic::searchAndAddAssignment(
+void
+PUPHeuristic::addAssignment(
 	Var variable,
-	Pu pu )
+	unsigned int unit )
 {
 	unsigned int current = index - 1;			// because index gets incremented each time a new node is acquired from the order
+	unsigned int cell = unit * nodeNames.size( ) + order[ current ];
 
 	if ( current < assignments.size( ) )
-	{
 		assignments[ current ].variable = variable;
-		assignments[ current ].currentPu = pu;
-
-		if ( std::find( assignments[ current ].triedUnits.begin( ), assignments[ current ].triedUnits.end( ), pu.var ) == assignments[ current ].triedUnits.end( ) )
-			assignments[ current ].triedUnits.push_back( pu.var );
-
-		return true;
-	}
 	else
 	{
 		Assignment a;
 
 		a.variable = variable;
-		a.currentPu = pu;
-		a.triedUnits.push_back( pu.var );
+		a.triedBegin = triedCells.size( );
 
 		assignments.push_back( a );
+	}
 
-		return false;
+	if ( !tried[ cell ] )
+	{
+		tried[ cell ] = true;
+		triedCells.push_back( cell );
 	}
 }
 
 /*
- * gets all tried partner units from the given node
- *
- * @param node	the node ( zone or sensor )
- * @param trie	the units tried by this node ( out )
- * @return		true if there are tried units or false otherwise
+ * removes the last assignment, and the units tried since it was added
  */
-bool
-PUPHeuristic::getTriedAssignments(
-	Node* node,
-	vector < Var >* tried )
+void
+PUPHeuristic::popAssignment(
+	)
 {
-	unsigned int current = index - 1;			// because index gets incremented each time a new node is acquired from the order
+	assert( !assignments.empty( ) );
 
-	if ( current < assignments.size( ) )
+	while ( triedCells.size( ) > assignments.back( ).triedBegin )
 	{
-		*tried = assignments[ current ].triedUnits;
-		return true;
+		tried[ triedCells.back( ) ] = false;
+		triedCells.pop_back( );
 	}
 
-	return false;
+	assignments.pop_back( );
 }
 
 /*
  * gets an unused partner unit
  *
- * @param pu	the partner unit ( out )
+ * @param unit	the partner unit ( out )
  * @return		true if there is an unused partner unit or false otherwise
  */
 bool
 PUPHeuristic::getUnusedPu(
-	Pu* pu )
+	unsigned int* unit ) const
 {
-	bool used = false;
-
-	for ( unsigned int i = 0; i < partnerUnits.size( ); i++ )
+	for ( unsigned int pu : partnerUnits )
 	{
-		used = false;
-
-		for ( unsigned int j = 0; j < partnerUnits[ i ].usedIn.size( ) && !used; j++ )
+		if ( !isPartnerUsed( pu ) )
 		{
-			if ( solver.getTruthValue( partnerUnits[ i ].usedIn[ j ]->positive ) == TRUE )
-				used = true;
-		}
-
-		if ( !used )
-		{
-			*pu = partnerUnits[ i ];
+			*unit = pu;
 			return true;
 		}
 	}
@@ -510,68 +687,26 @@ PUPHeuristic::getUnusedPu(
 }
 
 /*
- * determines if the partner is already in use
- *
- * @return	true if the unit is used or false otherwise
- */
-bool
-PUPHeuristic::isPartnerUsed(
-	Pu pu )
-{
-	bool found = false;
-
-	for ( unsigned int i = 0; i < pu.usedIn.size( ) && !found; i++ )
-	{
-		if ( solver.getTruthValue( pu.usedIn[ i ]->positive ) == TRUE )
-			found = true;
-	}
-
-	return found;
-}
-
-/*
- * gets an unused partner unit
+ * gets a used partner unit not tried for the node yet
  *
- * @param pu	the partner unit ( out )
- * @param tried	the partner units already tried
+ * @param node	the node ( zone or sensor )
+ * @param unit	the partner unit ( out )
  */
 bool
 PUPHeuristic::getUntriedPu(
-	Pu* pu,
-	vector < Var > tried )
+	unsigned int node,
+	unsigned int* unit ) const
 {
-	bool found = false;
-
-	for ( unsigned int i = 0; i < partnerUnits.size( ) && !found; i++ )
+	for ( unsigned int pu : partnerUnits )
 	{
-		if ( ( std::find( tried.begin(), tried.end(), partnerUnits[ i ].var ) == tried.end() ) && isPartnerUsed( partnerUnits[ i ] ) )
+		if ( !tried[ pu * nodeNames.size( ) + node ] && isPartnerUsed( pu ) )
 		{
-			*pu = partnerUnits[ i ];
-			found = true;
+			*unit = pu;
+			return true;
 		}
 	}
 
-	return found;
-}
-
-bool
-PUPHeuristic::getPu(
-	Var assignment,
-	Pu *pu )
-{
-	string unit;
-	string node;
-	bool found = false;
-
-	HeuristicUtil::getName( VariableNames::getName( assignment ), &unit, &node );
-
-	for ( unsigned int i = 0; i < partnerUnits.size( ) && !found; i++ )
-	{
-		if ( partnerUnits[ i ].name == unit )
-			*pu = partnerUnits[ i ];
-	}
-
-	return found;
+	return false;
 }
 
 /*
@@ -580,10 +715,9 @@ PUPHeuristic::getPu(
 Literal
 PUPHeuristic::makeAChoiceProtected( )
 {
-	Pu pu;
-	Node* current;
+	unsigned int unit;
+	unsigned int current;
 	Var chosenVariable;
-	Assignment a;
 	bool found;
 
 //	add clauses like this
@@ -638,8 +772,8 @@ PUPHeuristic::makeAChoiceProtected( )
 						allTrue = false;
 						index = i;
 
-						while ( index < ( assignments.size( ) - 1 ) )
-							assignments.pop_back( );
+						while ( index + 1 < assignments.size( ) )
+							popAssignment( );
 					}
 				}
 
@@ -670,15 +804,15 @@ PUPHeuristic::makeAChoiceProtected( )
 						{
 							found = true;
 							index = pos;
-							trace_msg( heuristic, 4, "Reset index to node " << order[ pos ]->name << " ( index " << pos << " ) due to conflict" );
+							trace_msg( heuristic, 4, "Reset index to node " << nodeNames[ order[ pos ] ] << " ( index " << pos << " ) due to conflict" );
 						}
 						else
 							pos++;
 					}
 
 					// pop assignments for zones/sensor after the current index
-					while ( index < ( assignments.size( ) - 1 ) )
-						assignments.pop_back( );
+					while ( index + 1 < assignments.size( ) )
+						popAssignment( );
 
 					conflictHandled = true;
 					sNumberOfConflicts++;
@@ -710,43 +844,40 @@ PUPHeuristic::makeAChoiceProtected( )
 			current = order[ index++ ];
 
 			// check if the current node is already assigned - take next if so
-			for ( unsigned int i = 0; i < current->usedIn.size( ) && !found; i++ )
+			for ( unsigned int i = nodeAssignmentsBegin[ current ]; nodeUsage[ current ] > 0 && i < nodeAssignmentsBegin[ current + 1 ] && !found; i++ )
 			{
-				ZoneAssignment* za = current->usedIn[ i ];
-				if ( solver.getTruthValue( za->positive ) == TRUE )
+				const UnitAssignment& ua = nodeAssignments[ i ];
+				if ( solver.getTruthValue( ua.variable ) == TRUE )
 				{
 					found = true;
 
-					trace_msg( heuristic, 3, "Node " << current->name << " is already assigned with "
-							                         << za->positive << " " << Literal(za->positive, POSITIVE)
+					trace_msg( heuristic, 3, "Node " << nodeNames[ current ] << " is already assigned with "
+							                         << ua.variable << " " << Literal( ua.variable, POSITIVE )
 							                         << " -> continue with next zone/sensor");
 
-					getPu( za->positive, &pu );
-					searchAndAddAssignment( za->positive, pu );
+					addAssignment( ua.variable, ua.unit );
 				}
 			}
 		}
 		while( found );
 
-		vector < Var > tried;
-
 		// get unused partner unit first
-		if ( !getTriedAssignments( current, &tried ) )
+		if ( !isRevisited( ) )
 		{
-			if ( getUnusedPu( &pu ) )
+			if ( getUnusedPu( &unit ) )
 			{
-				chosenVariable = getVariable( &pu, current );
-				searchAndAddAssignment( chosenVariable, pu );
+				chosenVariable = getVariable( unit, current );
+				addAssignment( chosenVariable, unit );
 			}
 		}
 
 		// try all used afterwards
 		if ( chosenVariable == 0 )
 		{
-			if ( getUntriedPu( &pu, tried ) )
+			if ( getUntriedPu( current, &unit ) )
 			{
-				chosenVariable = getVariable( &pu, current );
-				searchAndAddAssignment( chosenVariable, pu );
+				chosenVariable = getVariable( unit, current );
+				addAssignment( chosenVariable, unit );
 			}
 		}
 
@@ -763,7 +894,7 @@ PUPHeuristic::makeAChoiceProtected( )
 				while ( solver.getTruthValue( assignments[ index ].variable ) != UNDEFINED )
 					solver.unrollOne( );
 
-				assignments.pop_back( );
+				popAssignment( );
 
 				conflictOccured = true;
 				sNumberOfBacktracks++;
@@ -796,34 +927,6 @@ PUPHeuristic::makeAChoiceProtected( )
 	return Literal( chosenVariable, POSITIVE );
 }
 
-/*
- * return the variable for assigning the given node to the given unit
- *
- * @param  node 	the node to assign to
- * @param  unit		the unit
- * @return the variable
- */
-Var
-PUPHeuristic::getVariable (
-	Pu *unit,
-	Node *node )
-{
-	Var var = 0;
-	bool found = false;
-	vector < ZoneAssignment* > za = node->usedIn;
-
-	for ( unsigned int i = 0; i < za.size( ) && !found; i++ )
-	{
-		if ( za[ i ]->pu == unit->name )
-		{
-			found = true;
-			var = za[ i ]->positive;
-		}
-	}
-
-	return var;
-}
-
 /*
  * handle conflict
  */
@@ -839,11 +942,12 @@ void
 PUPHeuristic::onFinishedSolving(
 	)
 {
+	solver.notifyAssigned( );
 	printStatistics( );
 
 //	vector < Var > trueInAS;
 //	vector < Var > falseInAS;
-//	vector < Pu* > removed;
+//	vector < unsigned int > removed;
 //
 //	trace_msg( heuristic, 1, "Minimize solution" );
 //
@@ -859,117 +963,110 @@ PUPHeuristic::onFinishedSolving(
 //		cout <<"\t" << VariableNames::getName( v ) << endl;
 //
 //	cout << "removed pu" << endl;
-//	for ( Pu* pu : removed )
-//		cout <<"\t" << pu->name << endl;
+//	for ( unsigned int unit : removed )
+//		cout <<"\t" << unitNames[ unit ] << endl;
 }
 
 void
 PUPHeuristic::minimize(
 	vector< Var >* trueInAS,
 	vector< Var>* falseInAS,
-	vector< Pu* >* removed)
+	vector< unsigned int >* removed )
 {
-	unsigned int found = 0;
 	unsigned int nZones;
 	unsigned int nSensors;
 	unsigned int nPartners;
 
+	vector < vector < unsigned int > > connectedTo( unitNames.size( ) );
+	vector < unsigned int > numberOfZones( unitNames.size( ), 0 );
+	vector < unsigned int > numberOfSensors( unitNames.size( ), 0 );
+	vector < unsigned int > numberOfPartners( unitNames.size( ), 0 );
+	vector < bool > isRemoved( unitNames.size( ), false );
+
 	trace_msg( heuristic, 2, "Analyse partner unit connection" );
-	for ( PartnerUnitConnection puc : partnerUnitConnections )
+	for ( const Relation& puc : partnerUnitConnections )
 	{
-		found = 0;
-
 		if ( solver.getTruthValue( puc.variable ) == TRUE )
 		{
-			Pu* unit1 = 0;
-			Pu* unit2 = 0;
-			for ( unsigned int i = 0; i < partnerUnits.size( ) && !found < 2; i++ )
-			{
-				if ( puc.unit1 == partnerUnits[ i ].name && unit1 == 0 )
-				{
-					unit1 = &partnerUnits[ i ];
-					found++;
-				}
-				else if ( puc.unit2 == partnerUnits[ i ].name && unit2 == 0 )
-				{
-					unit2 = &partnerUnits[ i ];
-					found++;
-				}
-			}
+			unsigned int unit1 = puc.first;
+			unsigned int unit2 = puc.second;
 
-			if ( std::find( unit1->connectedTo.begin( ), unit1->connectedTo.end( ), unit2 ) == unit1->connectedTo.end( ) )
-				unit1->connectedTo.push_back( unit2 );
-			if ( std::find( unit2->connectedTo.begin( ), unit2->connectedTo.end( ), unit1 ) == unit2->connectedTo.end( ) )
-				unit2->connectedTo.push_back( unit1 );
+			if ( std::find( connectedTo[ unit1 ].begin( ), connectedTo[ unit1 ].end( ), unit2 ) == connectedTo[ unit1 ].end( ) )
+				connectedTo[ unit1 ].push_back( unit2 );
+			if ( std::find( connectedTo[ unit2 ].begin( ), connectedTo[ unit2 ].end( ), unit1 ) == connectedTo[ unit2 ].end( ) )
+				connectedTo[ unit2 ].push_back( unit1 );
 		}
 	}
 
 	trace_msg( heuristic, 2, "Count connected zones/sensors/partners" );
-	for ( unsigned int i = 0; i < partnerUnits.size( ); i++ )
+	for ( unsigned int unit : partnerUnits )
 	{
-		for ( ZoneAssignment* za : partnerUnits[ i ].usedIn )
+		for ( unsigned int i = unitAssignmentsBegin[ unit ]; i < unitAssignmentsBegin[ unit + 1 ]; i++ )
 		{
-			if ( solver.getTruthValue( za->positive ) == TRUE )
+			if ( solver.getTruthValue( unitAssignments[ i ].variable ) == TRUE )
 			{
-				if ( za->type == ZONE )
-					partnerUnits[ i ].numberOfZones++;
+				if ( nodeTypes[ unitAssignments[ i ].node ] == ZONE )
+					numberOfZones[ unit ]++;
 				else
-					partnerUnits[ i ].numberOfSensors++;
+					numberOfSensors[ unit ]++;
 			}
 		}
 
-		partnerUnits[ i ].numberOfPartners = partnerUnits[ i ].connectedTo.size( );
+		numberOfPartners[ unit ] = connectedTo[ unit ].size( );
 	}
 
 	trace_msg( heuristic, 2, "Start minimizing" );
 	for ( unsigned int i = 0; i < partnerUnits.size( ); i++ )
 	{
+		unsigned int unit1 = partnerUnits[ i ];
+
 		// add nodes/sensors from unit i to minimized ones (they can not be removed
-		if ( partnerUnits[ i ].removed == false )
+		if ( isRemoved[ unit1 ] == false )
 		{
-			for ( ZoneAssignment* za : partnerUnits[ i ].usedIn )
+			for ( unsigned int k = unitAssignmentsBegin[ unit1 ]; k < unitAssignmentsBegin[ unit1 + 1 ]; k++ )
 			{
-				if ( solver.getTruthValue( za->positive ) == TRUE )
-					trueInAS->push_back( za->positive );
+				if ( solver.getTruthValue( unitAssignments[ k ].variable ) == TRUE )
+					trueInAS->push_back( unitAssignments[ k ].variable );
 			}
 		}
 
 		// check following partner units (remove if neccesary)
 		for ( unsigned int j = i + 1; j < partnerUnits.size( ); j++ )
 		{
-			nPartners = partnerUnits[ i ].numberOfPartners + partnerUnits[ j ].numberOfPartners;
-			if ( std::find( partnerUnits[ i ].connectedTo.begin( ), partnerUnits[ i ].connectedTo.end( ), &partnerUnits[ j ] ) != partnerUnits[ i ].connectedTo.end( ) )
+			unsigned int unit2 = partnerUnits[ j ];
+
+			nPartners = numberOfPartners[ unit1 ] + numberOfPartners[ unit2 ];
+			if ( std::find( connectedTo[ unit1 ].begin( ), connectedTo[ unit1 ].end( ), unit2 ) != connectedTo[ unit1 ].end( ) )
 				nPartners-=2;
-			nZones = partnerUnits[ i ].numberOfZones + partnerUnits[ j ].numberOfZones;
-			nSensors = partnerUnits[ i ].numberOfSensors + partnerUnits[ j ].numberOfSensors;
+			nZones = numberOfZones[ unit1 ] + numberOfZones[ unit2 ];
+			nSensors = numberOfSensors[ unit1 ] + numberOfSensors[ unit2 ];
 
 			if ( nZones <= maxElementsOnPu &&
 				 nSensors <= maxElementsOnPu &&
 				 nPartners <= maxPu &&
-				 partnerUnits[ i ].removed == false &&
-				 partnerUnits[ j ].removed == false )
+				 isRemoved[ unit1 ] == false &&
+				 isRemoved[ unit2 ] == false )
 			{
-				trace_msg( heuristic, 3, "Merge unit " << partnerUnits[ i ].name << " and unit " << partnerUnits[ j ].name << " (unit " << partnerUnits[ j ].name << " is removed)" );
+				trace_msg( heuristic, 3, "Merge unit " << unitNames[ unit1 ] << " and unit " << unitNames[ unit2 ] << " (unit " << unitNames[ unit2 ] << " is removed)" );
 
-				partnerUnits[ i ].numberOfZones = nZones;
-				partnerUnits[ i ].numberOfSensors = nSensors;
-				partnerUnits[ i ].numberOfPartners = nPartners;
-				partnerUnits[ j ].removed = true;
+				numberOfZones[ unit1 ] = nZones;
+				numberOfSensors[ unit1 ] = nSensors;
+				numberOfPartners[ unit1 ] = nPartners;
+				isRemoved[ unit2 ] = true;
 
-				removed->push_back( &partnerUnits[ j ] );
+				removed->push_back( unit2 );
 
-				for ( ZoneAssignment* za1 : partnerUnits[ i ].usedIn )
+				for ( unsigned int k = unitAssignmentsBegin[ unit2 ]; k < unitAssignmentsBegin[ unit2 + 1 ]; k++ )
 				{
-					for ( ZoneAssignment* za2 : partnerUnits[ j ].usedIn )
+					// add nodes/sensors from unit2 to unit1 (and minimized ones)
+					const UnitAssignment& ua2 = unitAssignments[ k ];
+					Var variable1 = getVariable( unit1, ua2.node );
+					if ( solver.getTruthValue( ua2.variable ) == TRUE && variable1 != 0 )
 					{
-						// add nodes/sensors from unit2 to unit1 (and minimized ones)
-						if ( solver.getTruthValue( za2->positive ) == TRUE && za1->to == za2->to )
-						{
-							trace_msg( heuristic, 4, "Move " << ( za2->type == ZONE ? "zone " : "sensor ") << za2->to << " from unit " << partnerUnits[ i ].name << " to unit " << partnerUnits[ j ].name );
+						trace_msg( heuristic, 4, "Move " << ( nodeTypes[ ua2.node ] == ZONE ? "zone " : "sensor ") << nodeNames[ ua2.node ] << " from unit " << unitNames[ unit1 ] << " to unit " << unitNames[ unit2 ] );
 
-							trueInAS->push_back( za1->positive );
-							falseInAS->push_back( za2->positive );
-						}
+						trueInAS->push_back( variable1 );
+						falseInAS->push_back( ua2.variable );
 					}
 				}
 			}
@@ -982,19 +1079,11 @@ PUPHeuristic::printStatistics(
 	)
 {
 	unsigned int partnerUnitsUsed = 0;
-	bool found;
 
-	for ( Pu pu : partnerUnits )
+	for ( unsigned int unit : partnerUnits )
 	{
-		found = false;
-		for ( unsigned int i = 0; i < pu.usedIn.size( ) && !found; i++ )
-		{
-			if ( solver.getTruthValue( pu.usedIn[ i ]->positive ) == TRUE )
-			{
-				found = true;
-				partnerUnitsUsed++;
-			}
-		}
+		if ( isPartnerUsed( unit ) )
+			partnerUnitsUsed++;
 	}
 
 	cout << sNumberOfConflicts << " conflicts occured" << endl;
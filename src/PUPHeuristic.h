@@ -19,11 +19,11 @@
 #ifndef PUPHEURISTIC_H
 #define	PUPHEURISTIC_H
 
+#include <deque>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#define U2Z 1
-#define U2S 2
 #define ZONE 1
 #define SENSOR 2
 
@@ -60,12 +60,18 @@ class PUPHeuristic : public Heuristic
         void conflictOccurred( );
         unsigned int getTreshold( ){ return numberOfConflicts; };
         void onFinishedSolving( );
+        void subscribeAtoms( AtomDispatcher& dispatcher );
+        void onAtom( const Atom& atom );
+        void getPreferredLiterals( vector< Literal >& literals );
+        void onAssigned( const vector< Literal >& literals );
+        void onUnassigned( const vector< Var >& variables );
 
     protected:
         Literal makeAChoiceProtected();
 
     private:
 		unsigned int startAt;					// current starting node
+		unsigned int numberOfStarts;			// starting nodes whose orders are evaluated together
 		unsigned int index;						// current order index ( next node to be considered )
 		unsigned int maxPu;						// maximum number of partner units per unit
 		unsigned int maxElementsOnPu;			// maximum number of zones/sensors per unit
@@ -82,93 +88,119 @@ class PUPHeuristic : public Heuristic
 		unsigned int sNumberOfRecommendations;
 		unsigned int sNumberOfOrderMaxReached;
 
-		// represents a zone to sensor connection ( positive and negative variable )
-		struct ZoneAssignment
+		// an atom relating two interned ids ( zone2sensor, unit2zone, unit2sensor or partnerunits )
+		struct Relation
 		{
-			string pu;
-			string to;
-			Var positive;
-			unsigned int type;
-		};
-
-		// represents either a zone or a sensor
-		struct Node
-		{
-			string name;
-			Var var;
-			vector < Node* > children;			// all sensors connected to this zone ( or vice versa )
-			unsigned int type;					// ZONE or SENSOR
-			unsigned int considered;
-
-			vector < ZoneAssignment* > usedIn;
-		};
-
-		// represents a partner unit
-		struct Pu
-		{
-			string name;
-			Var var;
-
-			vector < ZoneAssignment* > usedIn;
-
-			vector < Pu* > connectedTo;
-			unsigned int numberOfZones;
-			unsigned int numberOfSensors;
-			unsigned int numberOfPartners;
-			bool removed;
+			unsigned int first;
+			unsigned int second;
+			Var variable;
 		};
 
-		// represents a zone to sensor connection
-		struct Connection
+		// the assignment of a node to a partner unit
+		struct UnitAssignment
 		{
-			string from;
-			string to;
-			Var var;
+			unsigned int unit;
+			unsigned int node;
+			Var variable;
 		};
 
-		// represents an assignment done by the heuristic
+		// represents an assignment done by the heuristic ( the cells tried since it was added start at triedBegin in triedCells )
 		struct Assignment
 		{
 			Var variable;
-			Pu currentPu;
-			vector < Var > triedUnits;
+			unsigned int triedBegin;
 		};
 
-		struct PartnerUnitConnection
+		// an order evaluated for a starting zone, with the width of its BFS layout ( UINT_MAX if not feasible )
+		struct ScoredOrder
 		{
-			Var variable;
-			string unit1;
-			string unit2;
+			unsigned int start;
+			unsigned int width;
+			vector < unsigned int > order;
 		};
 
 		vector < Var > variables;
-        vector < Node > zones;
-		vector < Node > sensors;
-		vector < Pu > partnerUnits;
-		vector < Connection > zone2sensor;		// input relation for creating zone assignments
-		vector < ZoneAssignment > unit2zone;
-		vector < ZoneAssignment > unit2sensor;
-		vector < PartnerUnitConnection > partnerUnitConnections;
-
-		vector < Node* > order;					// current node order
+
+		// signatures of the atoms read
+		unsigned int zoneSignature;
+		unsigned int doorSensorSignature;
+		unsigned int zone2sensorSignature;
+		unsigned int comUnitSignature;
+		unsigned int unit2zoneSignature;
+		unsigned int unit2sensorSignature;
+		unsigned int maxElementsSignature;
+		unsigned int maxPUSignature;
+		unsigned int partnerunitsSignature;
+
+		// nodes ( zones and sensors ) and partner units, interned to consecutive ids from the ids of their terms
+		unordered_map < unsigned int, unsigned int > zoneIds;
+		unordered_map < unsigned int, unsigned int > sensorIds;
+		unordered_map < unsigned int, unsigned int > unitIds;
+		vector < string > nodeNames;
+		vector < unsigned int > nodeTypes;		// ZONE or SENSOR
+		vector < string > unitNames;
+
+		// declared zones, sensors and partner units, in input order
+		vector < unsigned int > zones;
+		vector < unsigned int > sensors;
+		vector < unsigned int > partnerUnits;
+
+		// atoms collected while parsing
+		vector < Relation > zone2sensor;
+		vector < Relation > unit2zone;
+		vector < Relation > unit2sensor;
+		vector < Relation > partnerUnitConnections;
+
+		// connected nodes, and assignments of nodes and of units, in compressed sparse row form
+		vector < unsigned int > childrenBegin;
+		vector < unsigned int > children;
+		vector < unsigned int > nodeAssignmentsBegin;
+		vector < UnitAssignment > nodeAssignments;
+		vector < unsigned int > unitAssignmentsBegin;
+		vector < UnitAssignment > unitAssignments;
+
+		// per unit and node data, at position unit * nodeNames.size( ) + node
+		vector < Var > assignmentVariables;
+		vector < bool > tried;
+		vector < bool > cellTrue;				// true if the assignment has been notified as true
+
+		// assignments notified as true by the solver: the cell of each assignment variable
+		// ( UINT_MAX otherwise ), and their number for each unit and for each node
+		vector < unsigned int > variableCell;
+		vector < unsigned int > unitUsage;
+		vector < unsigned int > nodeUsage;
+
+		vector < unsigned int > considered;		// per node: last order it was added to
+		vector < unsigned int > order;			// current node order
 		vector < Assignment > assignments;		// current assignments done by the heuristic
+		vector < unsigned int > triedCells;		// cells set in tried by the assignments, in order
 		vector < Var > undefined;
+		deque < ScoredOrder > pendingOrders;	// feasible orders not used yet, best first
+
+		unsigned int getZoneId ( const Atom& atom, unsigned int argument ) { return getNodeId( zoneIds, atom, argument, ZONE ); }
+		unsigned int getSensorId ( const Atom& atom, unsigned int argument ) { return getNodeId( sensorIds, atom, argument, SENSOR ); }
+		unsigned int getNodeId ( unordered_map < unsigned int, unsigned int >& ids, const Atom& atom, unsigned int argument, unsigned int type );
+		unsigned int getUnitId ( const Atom& atom, unsigned int argument );
 
 		void initRelation ( );
+		void initUnitAssignments ( );
+		void subscribeAssignments ( );
 		bool resetHeuristic ( );
-		void processVariable ( Var v );
-		void initUnitAssignments( ZoneAssignment pu, unsigned int type );
 		bool createOrder ( );
-
-		Var getVariable ( Pu *unit, Node *node );
-
-		bool searchAndAddAssignment( Var variable, Pu pu );
-		bool getTriedAssignments( Node* node, vector < Var >* tried );
-		bool getUnusedPu( Pu* pu );
-		bool isPartnerUsed( Pu pu );
-		bool getUntriedPu( Pu* pu, vector < Var > tried );
-		bool getPu( Var assignment, Pu *pu );
-		void minimize( vector< Var >* trueInAS, vector< Var>* falseInAS, vector< Pu* >* removed);
+		bool createScoredOrder ( );
+		void evaluateStarts ( );
+		bool buildOrder ( unsigned int start, vector < unsigned int >& nodeOrder, vector < unsigned int >& visited, unsigned int stamp ) const;
+		unsigned int getOrderWidth ( const vector < unsigned int >& nodeOrder, const vector < unsigned int >& visited, unsigned int stamp, vector < unsigned int >& position ) const;
+
+		Var getVariable ( unsigned int unit, unsigned int node ) const { return assignmentVariables[ unit * nodeNames.size( ) + node ]; }
+
+		void addAssignment( Var variable, unsigned int unit );
+		void popAssignment( );
+		bool isRevisited( ) const { return index - 1 < assignments.size( ); }	// index gets incremented each time a new node is acquired from the order
+		bool getUnusedPu( unsigned int* unit ) const;
+		bool isPartnerUsed( unsigned int unit ) const { return unitUsage[ unit ] > 0; }
+		bool getUntriedPu( unsigned int node, unsigned int* unit ) const;
+		void minimize( vector< Var >* trueInAS, vector< Var>* falseInAS, vector< unsigned int >* removed );
 		void printStatistics( );
 };
 
@@ -0,0 +1,190 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef PHASES_H
+#define PHASES_H
+
+#include <cassert>
+#include <cstdint>
+
+#include "Variables.h"
+#include "stl/Vector.h"
+#include "util/Constants.h"
+
+/*
+ * Polarities used for the choices of the solver.
+ *
+ * The saved phase of a variable is its last assigned value, which is kept by
+ * Variables after unrolling. On top of that, this class stores:
+ * - the initial phase, which can be seeded by domain heuristics and is used
+ *   for variables that have never been assigned;
+ * - the target phase, that is the assignment of the longest conflict-free
+ *   trail since the last rephase;
+ * - the best phase, that is the assignment of the longest conflict-free
+ *   trail since the last rephase to best.
+ * Target and best phases are tracked only when rephasing is enabled, that is
+ * when the interval is not 0. Every interval conflicts (the interval grows
+ * arithmetically) the saved phases are overwritten according to the cyclic
+ * schedule best, original, best, inverted, best, flip.
+ */
+class Phases
+{
+    public:
+        inline Phases( unsigned int interval );
+
+        inline void onNewVariable();
+        inline bool isEnabled() const { return interval != 0; }
+
+        inline void setInitialPhase( Var v, TruthValue value ) { assert( v < initial.size() ); initial[ v ] = value; }
+        inline TruthValue getInitialPhase( Var v ) const { return initial[ v ]; }
+        inline TruthValue getTargetPhase( Var v ) const { return target[ v ]; }
+
+        /**
+         * Updates target and best phases with the first size literals of the trail,
+         * which are known to be conflict-free.
+         */
+        inline void onConflictFreeTrail( Variables& variables, unsigned int size );
+
+        inline bool hasToRephase( uint64_t conflicts ) const { return isEnabled() && conflicts >= nextRephase; }
+        inline void rephase( Variables& variables, uint64_t conflicts );
+
+    private:
+        enum RephaseKind { REPHASE_BEST = 0, REPHASE_ORIGINAL, REPHASE_INVERTED, REPHASE_FLIP };
+
+        inline RephaseKind nextKind() const;
+        inline static void copyTrail( Variables& variables, unsigned int size, Vector< TruthValue >& phases );
+
+        Vector< TruthValue > initial;
+        Vector< TruthValue > target;
+        Vector< TruthValue > best;
+
+        unsigned int targetAssigned;
+        unsigned int bestAssigned;
+
+        unsigned int interval;
+        unsigned int numberOfRephases;
+        uint64_t nextRephase;
+};
+
+Phases::Phases(
+    unsigned int i ) : targetAssigned( 0 ), bestAssigned( 0 ), interval( i ), numberOfRephases( 0 ), nextRephase( i )
+{
+    onNewVariable();
+}
+
+void
+Phases::onNewVariable()
+{
+    initial.push_back( UNDEFINED );
+    target.push_back( UNDEFINED );
+    best.push_back( UNDEFINED );
+}
+
+void
+Phases::copyTrail(
+    Variables& variables,
+    unsigned int size,
+    Vector< TruthValue >& phases )
+{
+    for( unsigned int i = 0; i < size; i++ )
+    {
+        Var v = variables.getAssignedVariable( i );
+        phases[ v ] = variables.getTruthValue( v );
+    }
+}
+
+void
+Phases::onConflictFreeTrail(
+    Variables& variables,
+    unsigned int size )
+{
+    assert( isEnabled() );
+    if( size > targetAssigned )
+    {
+        copyTrail( variables, size, target );
+        targetAssigned = size;
+    }
+
+    if( size > bestAssigned )
+    {
+        copyTrail( variables, size, best );
+        bestAssigned = size;
+    }
+}
+
+Phases::RephaseKind
+Phases::nextKind() const
+{
+    switch( numberOfRephases % 6 )
+    {
+        case 1:
+            return REPHASE_ORIGINAL;
+        case 3:
+            return REPHASE_INVERTED;
+        case 5:
+            return REPHASE_FLIP;
+        default:
+            return REPHASE_BEST;
+    }
+}
+
+void
+Phases::rephase(
+    Variables& variables,
+    uint64_t conflicts )
+{
+    assert( isEnabled() );
+    RephaseKind kind = nextKind();
+    for( Var v = 1; v <= variables.numberOfVariables(); v++ )
+    {
+        if( !variables.isUndefined( v ) )
+            continue;
+
+        TruthValue value = UNDEFINED;
+        switch( kind )
+        {
+            case REPHASE_BEST:
+                value = best[ v ];
+                break;
+
+            case REPHASE_ORIGINAL:
+                value = initial[ v ] != UNDEFINED ? initial[ v ] : FALSE;
+                break;
+
+            case REPHASE_INVERTED:
+                value = initial[ v ] == TRUE ? FALSE : TRUE;
+                break;
+
+            case REPHASE_FLIP:
+                value = variables.getCachedTruthValue( v ) == TRUE ? FALSE : TRUE;
+                break;
+        }
+
+        if( value != UNDEFINED )
+            variables.setCachedTruthValue( v, value );
+        target[ v ] = UNDEFINED;
+    }
+
+    targetAssigned = 0;
+    if( kind == REPHASE_BEST )
+        bestAssigned = 0;
+    numberOfRephases++;
+    nextRephase = conflicts + ( uint64_t ) interval * ( numberOfRephases + 1 );
+}
+
+#endif
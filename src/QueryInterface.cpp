@@ -187,7 +187,7 @@ QueryInterface::reduceCandidates()
 Clause*
 QueryInterface::computeClauseFromCandidates()
 {
-    Clause* clause = new Clause();
+    Clause* clause = Clause::create();
     unsigned int j = 0;
     for( unsigned int i = 0; i < candidates.size(); i++ )
     {
@@ -0,0 +1,51 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "Reason.h"
+
+vector< Reason* > Reason::registry;
+vector< unsigned int > Reason::freeIds;
+
+unsigned int
+Reason::registerReason(
+    Reason* reason )
+{
+    unsigned int id;
+    if( !freeIds.empty() )
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+        registry[ id ] = reason;
+    }
+    else
+    {
+        id = registry.size();
+        registry.push_back( reason );
+    }
+    return id | REGISTERED;
+}
+
+void
+Reason::unregisterReason(
+    unsigned int r )
+{
+    unsigned int id = r & ~REGISTERED;
+    assert( id < registry.size() );
+    registry[ id ] = NULL;
+    freeIds.push_back( id );
+}
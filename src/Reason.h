@@ -19,6 +19,7 @@
 #ifndef REASON_H
 #define REASON_H
 
+#include <cassert>
 #include <iostream>
 #include <vector>
 using namespace std;
@@ -27,6 +28,11 @@ class Learning;
 class Literal;
 class Solver;
 
+/**
+ * Reasons are referred to by 32-bit references: clauses by their reference in
+ * ClauseAllocator, the other reasons by their index in a registry, tagged with
+ * the highest bit.
+ */
 class Reason
 {
     friend ostream& operator<<( ostream& o, const Reason& r )
@@ -35,12 +41,36 @@ class Reason
     }
     
     public:
-        virtual ~Reason() {}
+        static const unsigned int REGISTERED = 1u << 31;
+
+        inline Reason() : ref( registerReason( this ) ) {}
+        inline Reason( const Reason& ) : ref( registerReason( this ) ) {}
+        inline Reason& operator=( const Reason& ) { return *this; }
+        virtual ~Reason() { if( ref & REGISTERED ) unregisterReason( ref ); }
+
+        inline unsigned int getRef() const { return ref; }
+        static inline Reason* getRegistered( unsigned int r ) { assert( ( r & REGISTERED ) && ( r & ~REGISTERED ) < registry.size() ); return registry[ r & ~REGISTERED ]; }
+
         virtual void onLearning( const Solver& solver, Learning* strategy, Literal lit ) = 0;
         virtual bool onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit ) = 0;
         virtual bool isLearned() const { return false; }
         virtual ostream& print( ostream& o ) const = 0;
         virtual void onNavigatingForUnsatCore( const Solver& solver, vector< unsigned int >& visited, unsigned int numberOfCalls, Literal lit ) = 0;
+
+    protected:
+        /**
+         * Used by clauses, which are not registered.
+         */
+        inline Reason( unsigned int clauseRef ) : ref( clauseRef ) { assert( !( ref & REGISTERED ) ); }
+
+    private:
+        static unsigned int registerReason( Reason* reason );
+        static void unregisterReason( unsigned int r );
+
+        unsigned int ref;
+
+        static vector< Reason* > registry;
+        static vector< unsigned int > freeIds;
 };
 
 #endif
\ No newline at end of file
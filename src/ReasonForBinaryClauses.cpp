@@ -29,7 +29,7 @@ ReasonForBinaryClauses::onLearning(
     Learning* strategy,
     Literal )
 {
-    Literal lit = solver.createFromAssignedVariable( varId );
+    Literal lit = solver.createOppositeFromAssignedVariable( varId );
     strategy->onNavigatingLiteral( lit );
 }
 
@@ -39,7 +39,7 @@ ReasonForBinaryClauses::onNavigatingLiteralForAllMarked(
     Learning* strategy,
     Literal )
 {
-    Literal lit = solver.createFromAssignedVariable( varId );
+    Literal lit = solver.createOppositeFromAssignedVariable( varId );
     return strategy->onNavigatingLiteralForAllMarked( lit );
 }
 
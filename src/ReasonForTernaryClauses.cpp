@@ -0,0 +1,68 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "ReasonForTernaryClauses.h"
+#include "Solver.h"
+
+ReasonForTernaryClauses::~ReasonForTernaryClauses()
+{
+}
+
+void
+ReasonForTernaryClauses::onLearning(
+    const Solver& solver,
+    Learning* strategy,
+    Literal )
+{
+    assert_msg( solver.isFalse( first ) && solver.isFalse( second ), "Literals " << first << " and " << second << " must be false" );
+    if( solver.getDecisionLevel( first ) != 0 )
+        strategy->onNavigatingLiteral( first );
+    if( solver.getDecisionLevel( second ) != 0 )
+        strategy->onNavigatingLiteral( second );
+}
+
+bool
+ReasonForTernaryClauses::onNavigatingLiteralForAllMarked(
+    const Solver& solver,
+    Learning* strategy,
+    Literal )
+{
+    if( solver.getDecisionLevel( first ) != 0 && !strategy->onNavigatingLiteralForAllMarked( first ) )
+        return false;
+    return solver.getDecisionLevel( second ) == 0 || strategy->onNavigatingLiteralForAllMarked( second );
+}
+
+ostream&
+ReasonForTernaryClauses::print(
+    ostream& o ) const
+{
+    return o << "[ " << first << " | " << second << " ]";
+}
+
+void
+ReasonForTernaryClauses::onNavigatingForUnsatCore(
+    const Solver& solver,
+    vector< unsigned int >& visited,
+    unsigned int numberOfCalls,
+    Literal )
+{
+    if( solver.getDecisionLevel( first ) > 0 )
+        visited[ first.getVariable() ] = numberOfCalls;
+    if( solver.getDecisionLevel( second ) > 0 )
+        visited[ second.getVariable() ] = numberOfCalls;
+}
@@ -0,0 +1,52 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef REASONFORTERNARYCLAUSES_H
+#define REASONFORTERNARYCLAUSES_H
+
+#include <iostream>
+using namespace std;
+#include "util/Constants.h"
+
+#include "Literal.h"
+#include "Reason.h"
+
+/**
+ * Reason of a literal inferred by a ternary clause stored in the implication
+ * lists of the solver. Since these clauses are not represented by Clause
+ * objects, the two false literals of the clause are copied here before the
+ * inference.
+ */
+class ReasonForTernaryClauses : public Reason
+{
+    public:        
+        inline ReasonForTernaryClauses() {}
+        virtual ~ReasonForTernaryClauses();
+        virtual void onLearning( const Solver& solver, Learning* strategy, Literal lit );
+        virtual bool onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit );        
+        virtual ostream& print( ostream& o ) const;
+        void onNavigatingForUnsatCore( const Solver& solver, vector< unsigned int >& toVisit, unsigned int numberOfCalls, Literal lit );
+        
+        inline void set( Literal lit1, Literal lit2 ) { first = lit1; second = lit2; }
+
+    private:
+        Literal first;
+        Literal second;
+};
+
+#endif
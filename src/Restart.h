@@ -19,83 +19,34 @@
 #ifndef RESTART_H
 #define RESTART_H
 
-#include <cassert>
-#include <cmath>
-
+/*
+ * Restart policy of the solver.
+ *
+ * The solver notifies every conflict (with the size of the trail when the
+ * conflict is detected) and the LBD of every learned clause that is not
+ * unary, and asks whether a restart is due once per choice.
+ */
 class Restart
 {
     public:
-        inline Restart( unsigned int threshold = 100, bool lubyRestars = true );
-        inline bool hasToRestart();
-        inline void onRestart(){ conflictsCount = 0; }
-        inline Restart* clone() const { return new Restart( *this ); }
+        virtual ~Restart() {}
 
-    private:                
-        inline double luby( double, int );
-        inline void computeRestartBase();
-        inline void computeNextRestartValue();
+        virtual void onConflict( unsigned int ) {}
+        virtual void onLearnedClause( unsigned int ) {}
+        virtual bool hasToRestart() = 0;
+        virtual void onRestart() {}
 
-        unsigned int nextRestartValue;
-        unsigned int conflictsCount;        
-        unsigned int threshold;
-        unsigned int numberOfRestarts;
-        
-        double restartBase;
-        double restartIncrement;
-        bool lubyRestarts;       
+        /**
+         * Returns a policy with the same parameters and a fresh state.
+         */
+        virtual Restart* clone() const = 0;
 };
 
-Restart::Restart( 
-    unsigned int t,
-    bool luby ) : conflictsCount( 0 ), threshold( t ), numberOfRestarts( 0 ), restartBase( 0.0 ), restartIncrement( 2.0 ), lubyRestarts( luby )
-{
-    assert( threshold >= 32 );
-    computeNextRestartValue();
-}
-
-void
-Restart::computeRestartBase()
-{
-    restartBase = lubyRestarts ? luby( restartIncrement, numberOfRestarts ) : pow( restartIncrement, numberOfRestarts );
-}
-
-double
-Restart::luby(
-    double y,
-    int x )
+class NoRestart : public Restart
 {
-    // Find the finite subsequence that contains index 'x', and the
-    // size of that subsequence:
-    int size, seq;
-    for( size = 1, seq = 0; size < x + 1; seq++, size = 2 * size + 1 );
-
-    while( size - 1 != x )
-    {
-        size = ( size - 1 ) >> 1;
-        seq--;
-        x = x % size;
-    }
-    return pow( y, seq );
-}
-
-void
-Restart::computeNextRestartValue()
-{
-    computeRestartBase();
-    nextRestartValue =  restartBase * threshold;
-}
-
-bool
-Restart::hasToRestart()
-{
-    if( ++conflictsCount == nextRestartValue )
-    {
-        numberOfRestarts++;
-        computeNextRestartValue();
-        return true;
-    }
-
-    return false;
-}
+    public:
+        bool hasToRestart() { return false; }
+        Restart* clone() const { return new NoRestart(); }
+};
 
 #endif
@@ -279,44 +279,46 @@ Satelite::tryToEliminateByDefinition(
     Var variable = lit.getVariable();
     Literal oppositeLiteral = lit.getOppositeLiteral();
 
-    Clause negatedDefinition;
+    Clause* negatedDefinition = Clause::create();
     for( unsigned i = 0; i < solver.numberOfOccurrences( oppositeLiteral ); ++i )
     {
         Clause* clause = solver.getOccurrence( oppositeLiteral, i );
         if( clause->size() == 2 )
         {
             Literal literal = clause->getAt( 0 ).getVariable() == variable ? clause->getAt( 1 ).getOppositeLiteral() : clause->getAt( 0 ).getOppositeLiteral();
-            negatedDefinition.addLiteral( literal );
+            negatedDefinition->addLiteral( literal );
         }
     }
-    for( unsigned i = 0; i < negatedDefinition.size(); ++i )
+    for( unsigned i = 0; i < negatedDefinition->size(); ++i )
     {
-        if( isSubsumed( &negatedDefinition, negatedDefinition.getAt( i ) ) )
+        if( isSubsumed( negatedDefinition, negatedDefinition->getAt( i ) ) )
         {
             // DONE: propagate at level 0
             //Propagate the opposite literal
             ok = solver.propagateLiteralAsDeterministicConsequenceSatelite( oppositeLiteral );
+            delete negatedDefinition;
             return true;
         }
     }
     
-    negatedDefinition.addLiteral( Literal( lit ) );
+    negatedDefinition->addLiteral( Literal( lit ) );
     
     Clause* result = NULL;
     for( unsigned i = 0; i < solver.numberOfOccurrences( lit ); ++i )
     {
         Clause* clause = solver.getOccurrence( lit, i );
-        if( subset( clause, &negatedDefinition ) )
+        if( subset( clause, negatedDefinition ) )
         {
             if( result == NULL || result->size() >= clause->size() )
                 result = clause;
         }
     }
     
+    delete negatedDefinition;
     if( result == NULL )
         return false;
     
-    Clause* resultCopy = new Clause();
+    Clause* resultCopy = Clause::create();
     
     for( unsigned int i = 0; i < result->size(); i++ )
     {
@@ -354,7 +356,7 @@ Satelite::tryToSubstitute(
             if( clause->contains( definition->getAt( i ) ) )
                 continue;
 
-            Clause* newClause = new Clause();
+            Clause* newClause = Clause::create();
             for( unsigned k = 0; k < clause->size(); ++k )
                 newClause->addLiteral( clause->getAt( k ) == lit ? definition->getAt( i ).getOppositeLiteral() : clause->getAt( k ) );
             
@@ -382,7 +384,7 @@ Satelite::tryToSubstitute(
         if( clause->containsAnyComplementOf( definition ) )        
             continue;
 
-        Clause* newClause = new Clause();
+        Clause* newClause = Clause::create();
         for( unsigned k = 0; k < clause->size(); ++k )
         {
             if( clause->getAt( k ).getVariable() == variable )
@@ -481,7 +483,7 @@ Satelite::tryToEliminateByDistribution(
     {
         for( unsigned int j = 0; j < solver.numberOfOccurrences( neg ); j++ )
         {
-            Clause* newClause = new Clause();            
+            Clause* newClause = Clause::create();            
             Clause* firstClause = solver.getOccurrence( pos, i );
             Clause* secondClause = solver.getOccurrence( neg, i );
 
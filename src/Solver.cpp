@@ -17,6 +17,7 @@
  */
 
 #include "Solver.h"
+#include "AtomDispatcher.h"
 #include "input/Dimacs.h"
 #include "HCComponent.h"
 #include "weakconstraints/WeakInterface.h"
@@ -120,6 +121,20 @@ Solver::initFrom(
     this->glucoseHeuristic_ = solver.glucoseHeuristic_;
 }
 
+/*
+ * the atoms subscribed by the heuristic are read in a single pass over the names
+ */
+void
+Solver::onFinishedParsing()
+{
+    AtomDispatcher dispatcher;
+    heuristic->subscribeAtoms( dispatcher );
+    if( dispatcher.hasSubscriptions() )
+        dispatcher.dispatch( numberOfVariables() );
+
+    heuristic->onFinishedParsing();
+}
+
 void
 Solver::unroll(
     unsigned int level )
@@ -138,6 +153,7 @@ Solver::unroll(
         unrollLastVariable();
         toUnroll--;
     }
+    events.notifyUnassigned();
     
     while( toPop > 0 )
     {
@@ -488,7 +504,65 @@ Solver::shortPropagation(
         if( !isTrue( lit ) )
         {
             trace_msg( solving, 6, "Inferring " << lit << " as true" );        
-            assignLiteral( lit, variables.getReasonForBinaryClauses( variable ) );
+            //See unitPropagation: the conflict literal must be of the current level
+            if( isFalse( lit ) && getDecisionLevel( lit ) != currentDecisionLevel )
+                assignLiteral( complement, variables.getReasonForBinaryClauses( lit.getVariable() ) );
+            else
+                assignLiteral( lit, variables.getReasonForBinaryClauses( variable ) );
+        }
+    }
+}
+
+void
+Solver::ternaryPropagation(
+    Var variable )
+{
+    assert( !conflictDetected() );
+
+    Literal complement = variables.createOppositeLiteralFromAssignedVariable( variable );
+    Vector< TernaryImplication >& ternary = getDataStructure( complement ).variableTernaryClauses;
+
+    trace_msg( solving, 5, "Propagation of ternary clauses for literal " << complement );
+    for( unsigned i = 0; i < ternary.size(); ++i )
+    {
+        Literal first = ternary[ i ].first;
+        Literal second = ternary[ i ].second;
+        if( isTrue( first ) || isTrue( second ) )
+            continue;
+
+        Literal lit;
+        Literal other;
+        if( isFalse( first ) )
+        {
+            lit = second;
+            other = first;
+        }
+        else if( isFalse( second ) )
+        {
+            lit = first;
+            other = second;
+        }
+        else
+            continue;
+
+        if( isUndefined( lit ) )
+        {
+            trace_msg( solving, 6, "Inferring " << lit << " as true" );
+            ReasonForTernaryClauses* reason = variables.getReasonForTernaryClauses( lit.getVariable() );
+            reason->set( complement, other );
+            assignLiteral( lit, reason );
+        }
+        else
+        {
+            assert( isFalse( lit ) );
+            //The conflicting literal must be assigned at the current level.
+            if( getDecisionLevel( lit ) != currentDecisionLevel )
+                std::swap( lit, other );
+            trace_msg( solving, 6, "Conflict on " << lit );
+            conflictReasonForTernaryClauses.set( complement, other );
+            assignLiteral( lit, &conflictReasonForTernaryClauses );
+            assert( conflictDetected() );
+            break;
         }
     }
 }
@@ -501,20 +575,33 @@ Solver::unitPropagation(
     trace_msg( solving, 5, "Unit propagation" );
     Literal complement = variables.createOppositeLiteralFromAssignedVariable( variable );
 //    WatchedList< Clause* >& wl = variableWatchedLists[ ( getTruthValue( variable ) >> 1 ) ];
-    WatchedList< Clause* >& wl = getDataStructure( complement ).variableWatchedLists;
+    WatchedList< ClauseWatch >& wl = getDataStructure( complement ).variableWatchedLists;
 
     unsigned j = 0;
     for( unsigned i = 0; i < wl.size(); ++i )
     {
-        Clause* clause = wl[ j ] = wl[ i ];
+        ClauseWatch& watch = wl[ j ] = wl[ i ];
+        if( isTrue( watch.blocker ) )
+        {
+            ++j;
+            continue;
+        }
+
+        Clause* clause = Clause::get( watch.clause );
         assert_msg( clause != NULL, "Next clause to propagate is null." );
         trace_msg( solving, 6, "Considering clause " << *clause );
         if( onLiteralFalse( *clause, complement ) )
         {
             trace_msg( solving, 7, "Inferring literal " << clause->getAt( 0 ) << " using clause " << *clause );
+            watch.blocker = clause->getAt( 0 );
+            //After chronological backtracking the other watch may be false at a lower level: the conflict literal must be of the current level
+            if( isFalse( clause->getAt( 0 ) ) && getDecisionLevel( clause->getAt( 0 ) ) != currentDecisionLevel )
+                clause->swapWatchedLiterals();
             assignLiteral( clause );
             if( conflictDetected() )
             {
+                ++i;
+                ++j;
                 while( i < wl.size() )
                     wl[ j++ ] = wl[ i++ ];
                 break;
@@ -524,6 +611,7 @@ Solver::unitPropagation(
         else if( clause->getAt( 1 ) == complement )
         {
             assert( !conflictDetected() );
+            watch.blocker = clause->getAt( 0 );
             ++j;
         }
         else
@@ -653,6 +741,9 @@ Solver::propagateAtLevelZero(
     shortPropagation( variable );
     if( conflictDetected() )
         return;    
+    ternaryPropagation( variable );
+    if( conflictDetected() )
+        return;
     
     {        
         Literal literal = variables.createLiteralFromAssignedVariable( variable );
@@ -767,7 +858,26 @@ Solver::allClausesSatisfied() const
     return true;
 }
 
-bool compareClauses( Clause* c1, Clause* c2 ){ return c1->activity() < c2->activity(); }
+Activity
+Solver::selectDeletionThreshold(
+    unsigned int toDelete,
+    unsigned int& ties )
+{
+    ties = 0;
+    if( toDelete == 0 )
+        return 0;
+    
+    assert( toDelete <= deletionCandidates.size() );
+    nth_element( deletionCandidates.begin(), deletionCandidates.begin() + ( toDelete - 1 ), deletionCandidates.end() );
+    Activity threshold = deletionCandidates[ toDelete - 1 ];
+    
+    //nth_element leaves only smaller or equal activities before the threshold
+    ties = 1;
+    for( unsigned int i = 0; i < toDelete - 1; i++ )
+        if( deletionCandidates[ i ] == threshold )
+            ties++;
+    return threshold;
+}
 
 void
 Solver::minisatDeletion()
@@ -776,16 +886,22 @@ Solver::minisatDeletion()
     ClauseIterator j = learnedClauses_begin();
     Activity threshold = deletionCounters.increment / numberOfLearnedClauses();
     
-    stable_sort( learnedClauses.begin(), learnedClauses.end(), compareClauses );    
+    deletionCandidates.clear();
+    for( ClauseIterator it = learnedClauses_begin(); it != learnedClauses.end(); ++it )
+        if( !isLocked( **it ) )
+            deletionCandidates.push_back( ( *it )->activity() );
         
     unsigned int numberOfDeletions = 0;
     unsigned int size = numberOfLearnedClauses();
-    unsigned int toDelete = size / 2;
+    unsigned int ties;
+    Activity lowest = selectDeletionThreshold( min( size / 2, ( unsigned int ) deletionCandidates.size() ), ties );
     while( i != learnedClauses.end() )
     {
         Clause& clause = **i;
-        if( /*clause.size() > 2 &&*/ !isLocked( clause ) && ( numberOfDeletions < toDelete || clause.activity() < threshold ) )
+        if( /*clause.size() > 2 &&*/ !isLocked( clause ) && ( clause.activity() < lowest || clause.activity() < threshold || ( clause.activity() == lowest && ties > 0 ) ) )
         {
+            if( clause.activity() == lowest && ties > 0 )
+                ties--;
             deleteLearnedClause( i );
             numberOfDeletions++;
         }
@@ -802,85 +918,78 @@ Solver::minisatDeletion()
     statistics( this, onDeletion( size, numberOfDeletions ) );
 }
 
-bool compareClausesGlucose( Clause* c1Pointer, Clause* c2Pointer )
-{
-    Clause& c1 = *c1Pointer;
-    Clause& c2 = *c2Pointer;
-    
-    if( c2.size() == 2 )
-        return c1.size() > 2;
-    else
-    {
-        assert( c2.size() > 2 );
-        if( c1.size() == 2 )
-            return false;
-        
-        assert( c1.size() > 2 );        
-        if( c1.lbd() != c2.lbd() )
-            return c1.lbd() > c2.lbd();            
-        else
-            return c1.activity() < c2.activity();
-    }
-    
-    assert( 0 );
-    
-    //GLUCOSE VERSION:
-    
-//    bool operator () (CRef x, CRef y) { 
-// 
-//    // Main criteria... Like in MiniSat we keep all binary clauses
-//    if(ca[x].size()> 2 && ca[y].size()==2) return 1;
-//    
-//    if(ca[y].size()>2 && ca[x].size()==2) return 0;
-//    if(ca[x].size()==2 && ca[y].size()==2) return 0;
-//    
-//    // Second one  based on literal block distance
-//    if(ca[x].lbd()> ca[y].lbd()) return 1;
-//    if(ca[x].lbd()< ca[y].lbd()) return 0;    
-//    
-//    
-//    // Finally we can use old activity or size, we choose the last one
-//        return ca[x].activity() < ca[y].activity();
-//	//return x->size() < y->size();
-//
-//        //return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity()); } 
-//    } 
-}
-
 void
 Solver::glucoseDeletion()
 {
     assert( glucoseHeuristic_ );
+    assert( !learnedClauses.empty() );
     ClauseIterator i = learnedClauses_begin();
     ClauseIterator j = learnedClauses_begin();
     
-    stable_sort( learnedClauses.begin(), learnedClauses.end(), compareClausesGlucose );
+    unsigned int size = numberOfLearnedClauses();
+    unsigned int lowLbd = 0;
+    unsigned int minLbd = UINT_MAX;
+    unsigned int localClauses = 0;
+    deletionCandidates.clear();
+    for( ClauseIterator it = learnedClauses_begin(); it != learnedClauses.end(); ++it )
+    {
+        const Clause& clause = **it;
+        if( clause.lbd() <= 3 )
+            lowLbd++;
+        if( clause.lbd() < minLbd )
+            minLbd = clause.lbd();
+        
+        if( clause.tier() != LOCAL_TIER )
+            continue;
+        localClauses++;
+        if( !clause.used() && clause.canBeDeleted() && !isLocked( clause ) )
+            deletionCandidates.push_back( clause.activity() );
+    }
     
-    assert( !learnedClauses.empty() );
-    if( learnedClauses[ learnedClauses.size() / 2 ]->lbd() <= 3 )
+    //At least half of the clauses have a small lbd: postpone the next reduction
+    if( lowLbd >= size - size / 2 )
         glucoseData.nbclausesBeforeReduce += glucoseData.specialIncReduceDB;
     
-    if( learnedClauses.back()->lbd() <= 5 )
+    if( minLbd <= 5 )
         glucoseData.nbclausesBeforeReduce += glucoseData.specialIncReduceDB;
     
     unsigned int numberOfDeletions = 0;
-    unsigned int size = numberOfLearnedClauses();
-    unsigned int toDelete = size / 2;
+    unsigned int ties;
+    Activity threshold = selectDeletionThreshold( min( ( localClauses + 1 ) / 2, ( unsigned int ) deletionCandidates.size() ), ties );
     while( i != learnedClauses.end() )
     {
         Clause& clause = **i;
-        if( clause.lbd() > 2 && /*clause.size() > 2 &&*/ clause.canBeDeleted() && !isLocked( clause ) && ( numberOfDeletions < toDelete ) )
+        bool toDelete = false;
+        if( clause.tier() == TIER2 )
         {
-            deleteLearnedClause( i );
-            numberOfDeletions++;
+            //Clauses in the mid tier which have not been used since the last reduction are moved to the local tier
+            if( !clause.used() )
+                clause.setTier( LOCAL_TIER );
         }
-        else
+        else if( clause.tier() == LOCAL_TIER )
         {
             if( !clause.canBeDeleted() )
-            {
-                toDelete++;
                 clause.setCanBeDeleted( true );
+            else if( !clause.used() && !isLocked( clause ) )
+            {
+                if( clause.activity() < threshold )
+                    toDelete = true;
+                else if( clause.activity() == threshold && ties > 0 )
+                {
+                    ties--;
+                    toDelete = true;
+                }
             }
+        }
+        
+        if( toDelete )
+        {
+            deleteLearnedClause( i );
+            numberOfDeletions++;
+        }
+        else
+        {
+            clause.setUsed( false );
             *j = *i;
             ++j;
         }
@@ -892,6 +1001,31 @@ Solver::glucoseDeletion()
     statistics( this, onDeletion( size, numberOfDeletions ) );
 }
 
+void
+Solver::compactLearnedClauses()
+{
+    if( !ClauseAllocator::beginCompaction() )
+        return;
+
+    //Learned clauses are referred to by the watches of their first two literals and, if locked, by the implicant of the first one.
+    for( unsigned int i = 0; i < learnedClauses.size(); i++ )
+    {
+        Clause* clause = learnedClauses[ i ];
+        if( !ClauseAllocator::isEvacuated( clause->getRef() ) )
+            continue;
+
+        bool locked = isLocked( *clause );
+        detachClause( *clause );
+        Clause* moved = clause->copy();
+        attachClause( *moved );
+        if( locked )
+            setImplicant( moved->getAt( 0 ).getVariable(), moved );
+        releaseClause( clause );
+        learnedClauses[ i ] = moved;
+    }
+    ClauseAllocator::endCompaction();
+}
+
 //void
 //Solver::deleteClauses()
 //{
@@ -1303,6 +1437,8 @@ Solver::addLearnedClause(
             assert( !generator );
             hcComponentForChecker->addLearnedClausesFromChecker( learnedClause );
         }
+        if( glucoseHeuristic_ )
+            learnedClause->setTier( computeTier( learnedClause->lbd() ) );
         learnedClauses.push_back( learnedClause );        
     }    
 }
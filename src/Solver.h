@@ -34,6 +34,8 @@ using namespace std;
 #include "util/Assert.h"
 #include "Satelite.h"
 #include "Restart.h"
+#include "Phases.h"
+#include "SolverEvents.h"
 #include "MinisatHeuristic.h"
 #include "PUPHeuristic.h"
 #include "util/Statistics.h"
@@ -42,19 +44,44 @@ using namespace std;
 #include "Aggregate.h"
 #include "util/Constants.h"
 #include "WatchedList.h"
-#include "stl/BoundedQueue.h"
 #include "Component.h"
 class HCComponent;
 class WeakInterface;
 
+/**
+ * An entry of the implication lists of ternary clauses. The entry stored for
+ * a literal contains the other two literals of the clause.
+ */
+struct TernaryImplication
+{
+    Literal first;
+    Literal second;
+};
+
+/**
+ * An entry of a watched list. The blocker is a literal of the clause which is
+ * checked before accessing the clause: if it is true the clause is satisfied
+ * and the watch does not need to be updated.
+ * Two entries are equal if they refer to the same clause.
+ * The struct is an aggregate so that Vector can move entries with memcpy.
+ */
+struct ClauseWatch
+{
+    ClauseRef clause;
+    Literal blocker;
+
+    inline bool operator==( const ClauseWatch& other ) const { return clause == other.clause; }
+};
+
 class DataStructures
 {
     public:
-        WatchedList< Clause* > variableWatchedLists;
+        WatchedList< ClauseWatch > variableWatchedLists;
         Vector< Clause* > variableAllOccurrences;
         Vector< PostPropagator* > variablePostPropagators;
         Vector< pair< Propagator*, int > > variablePropagators;
         Vector< Literal > variableBinaryClauses;
+        Vector< TernaryImplication > variableTernaryClauses;
 
         DataStructures() : isOptimizationLiteral_( false ) {}
 
@@ -97,6 +124,7 @@ class Solver
         void propagateAtLevelZeroSatelite( Var variable );
         void unitPropagation( Var v );
         void shortPropagation( Var v );
+        void ternaryPropagation( Var v );
         void propagation( Var v );
         void postPropagation( Var v );        
 
@@ -108,7 +136,7 @@ class Solver
 //        inline void addVariable( const string& name );
         inline void addVariable();
         inline void addVariableRuntime();
-        inline void onFinishedParsing ( ) { heuristic->onFinishedParsing( ); }
+        void onFinishedParsing ( );
         inline void onFinishedSolving ( ) { heuristic->onFinishedSolving( ); }
         
         inline bool cleanAndAddClause( Clause* clause );
@@ -152,6 +180,7 @@ class Solver
         inline unsigned int numberOfLearnedClauses() const;         
         inline unsigned int numberOfAssignedLiterals() const;
         inline unsigned int numberOfVariables() const;
+        inline uint64_t getNumberOfConflicts() const { return conflicts; }
         
         inline Var getAssignedVariable( unsigned idx ) { return variables.getAssignedVariable( idx ); }
         
@@ -206,6 +235,8 @@ class Solver
         inline void deleteClauses() { glucoseHeuristic_ ? glucoseDeletion() : minisatDeletion(); }
         void minisatDeletion();
         void glucoseDeletion();
+        Activity selectDeletionThreshold( unsigned int toDelete, unsigned int& ties );
+        inline unsigned int computeTier( unsigned int lbd ) const { return lbd <= glucoseData.coreLBD ? CORE_TIER : ( lbd <= glucoseData.tier2LBD ? TIER2 : LOCAL_TIER ); }
         inline void decrementActivity(){ deletionCounters.increment *= deletionCounters.decrement; }
         inline void onLearning( Clause* learnedClause );        
         inline void markClauseForDeletion( Clause* clause ){ satelite->onDeletingClause( clause ); clause->markAsDeleted(); }
@@ -219,7 +250,8 @@ class Solver
 //        inline void initClauseData( Clause* clause ) { assert( heuristic != NULL ); heuristic->initClauseData( clause ); }
 //        inline Heuristic* getHeuristic() { return heuristic; }
         inline void onLiteralInvolvedInConflict( Literal l ) { heuristic->onLiteralInvolvedInConflict( l ); }
-        inline void finalizeDeletion( unsigned int newVectorSize ) { learnedClauses.resize( newVectorSize ); }        
+        inline void finalizeDeletion( unsigned int newVectorSize ) { learnedClauses.resize( newVectorSize ); compactLearnedClauses(); }        
+        void compactLearnedClauses();
         
         inline void setRestart( Restart* r );
         
@@ -296,9 +328,29 @@ class Solver
 
         inline TruthValue getTruthValue( Var v ) const { return variables.getTruthValue( v ); }
         inline TruthValue getCachedTruthValue( Var v ) const { return variables.getCachedTruthValue( v ); }
-        
-        inline void addWatchedClause( Literal lit, Clause* clause ) { getDataStructure( lit ).variableWatchedLists.add( clause ); }
-        inline void findAndEraseWatchedClause( Literal lit, Clause* clause ) { getDataStructure( lit ).variableWatchedLists.findAndRemove( clause ); }
+
+        /**
+         * Returns the literal of v to be chosen according to the phases of the solver.
+         */
+        inline Literal getChoiceLiteral( Var v ) const;
+        inline void setInitialPhase( Literal lit ) { phases.setInitialPhase( lit.getVariable(), lit.isPositive() ? TRUE : FALSE ); }
+
+        /**
+         * Subscribes the listener to the assignments of the variable, which must be
+         * undefined or assigned at level zero (then it is notified at once).
+         */
+        inline void subscribe( SolverListener* listener, Var v );
+        inline void subscribeConflicts( SolverListener* listener ) { events.subscribeConflicts( listener ); }
+        inline void subscribeRestarts( SolverListener* listener ) { events.subscribeRestarts( listener ); }
+
+        /**
+         * Notifies the assignments not notified yet, which is otherwise done before
+         * each choice (for instance after adding a clause from a heuristic).
+         */
+        inline void notifyAssigned() { events.notifyAssigned(); }
+        
+        inline void addWatchedClause( Literal lit, Clause* clause, Literal blocker ) { ClauseWatch watch = { clause->getRef(), blocker }; getDataStructure( lit ).variableWatchedLists.add( watch ); }
+        inline void findAndEraseWatchedClause( Literal lit, Clause* clause ) { ClauseWatch watch = { clause->getRef(), Literal::null }; getDataStructure( lit ).variableWatchedLists.findAndRemove( watch ); }
         
         inline void addClause( Literal lit, Clause* clause ) { getDataStructure( lit ).variableAllOccurrences.push_back( clause ); }
         inline void findAndEraseClause( Literal lit, Clause* clause ) { getDataStructure( lit ).variableAllOccurrences.findAndRemove( clause ); }
@@ -463,11 +515,12 @@ class Solver
         inline void addVariableInternal();        
         inline void addBinaryClause( Literal lit1, Literal lit2 );
         inline void addLiteralInShortClause( Literal firstLiteral, Literal secondLiteral ) { getDataStructure( firstLiteral ).variableBinaryClauses.push_back( secondLiteral ); }
+        inline void addTernaryClause( Literal lit1, Literal lit2, Literal lit3 );
         
         bool checkVariablesState();
         inline void setEliminated( Var v, unsigned int value, Clause* definition ) { variables.setEliminated( v, value, definition ); }        
         
-        Solver( const Solver& ) : learning( *this ), dependencyGraph( NULL )
+        Solver( const Solver& ) : learning( *this ), phases( 0 ), dependencyGraph( NULL )
         {
 //            dependencyGraph = new DependencyGraph( *this );
             assert( "The copy constructor has been disabled." && 0 );
@@ -479,16 +532,24 @@ class Solver
         vector< Clause* > clauses;
         vector< Clause* > learnedClauses;
         
+        /**
+         * Activities of the learned clauses that can be deleted by the current reduction.
+         */
+        vector< Activity > deletionCandidates;
+        
         vector< unsigned int > unrollVector;
         
         Literal conflictLiteral;        
         Reason* conflictClause;
+        ReasonForTernaryClauses conflictReasonForTernaryClauses;
         
         Learning learning;
         OutputBuilder* outputBuilder;        
         
         Heuristic* heuristic;
         Restart* restart;
+        Phases phases;
+        SolverEvents events;
         Satelite* satelite;                
         
         unsigned int getNumberOfUndefined() const;
@@ -522,7 +583,6 @@ class Solver
         
         bool glucoseHeuristic_;
         uint64_t conflicts;
-        uint64_t conflictsRestarts;                
         
         struct DeletionCounters
         {
@@ -553,54 +613,43 @@ class Solver
         
         struct GlucoseData
         {
-            double sizeLBDQueue;
-            double sizeTrailQueue;
-            double K;
-            double R;
-            
             //constants for reduce DB
             int nbclausesBeforeReduce;
             int incReduceDB;
             int specialIncReduceDB;
             unsigned int lbLBDFrozenClause;
             
+            //learned clauses with lbd up to coreLBD are never deleted,
+            //the ones up to tier2LBD are kept as long as they are used
+            unsigned int coreLBD;
+            unsigned int tier2LBD;
+            
             //constants for reducing clause
             int lbSizeMinimizingClause;
             unsigned int lbLBDMinimizingClause;
             
-            float sumLBD;
-            
             Vector< unsigned int > permDiff;
             
             unsigned int currRestart;
             
             unsigned int MYFLAG;
             
-            bqueue< unsigned int > lbdQueue;
-            bqueue< unsigned int > trailQueue;            
-            
             void init()
             {
-                sizeLBDQueue = 50;
-                sizeTrailQueue = 5000;
-                K = 0.8;
-                R = 1.4;
                 nbclausesBeforeReduce = 2000;
                 incReduceDB = 300;
                 specialIncReduceDB = 1000;
                 lbLBDFrozenClause = 30;
+                coreLBD = 2;
+                tier2LBD = 6;
                 
                 lbSizeMinimizingClause = 30;
                 lbLBDMinimizingClause = 6;
                 
-                sumLBD = 0.0;
                 currRestart = 1;
                 
                 permDiff.push_back( 0 );
                 MYFLAG = 0;
-                
-                lbdQueue.initSize( sizeLBDQueue );
-                trailQueue.initSize( sizeTrailQueue );
             }
             
             void onNewVariable() { permDiff.push_back( 0 ); }
@@ -657,6 +706,7 @@ Solver::Solver()
     learning( *this ),        
     outputBuilder( NULL ),
     restart( NULL ),
+    phases( wasp::Options::rephaseInterval ),
     assignedVariablesAtLevelZero( MAXUNSIGNEDINT ),
     nextValueOfPropagation( 0 ),
     literalsInClauses( 0 ),
@@ -667,7 +717,6 @@ Solver::Solver()
     callSimplifications_( true ),
     glucoseHeuristic_( true ),
     conflicts( 0 ),
-    conflictsRestarts( 0 ),
     numberOfAssumptions( 0 ),
     learnedFromPropagators( 0 ),
     learnedFromConflicts( 0 ),
@@ -727,7 +776,7 @@ Solver::solve(
     if( computeUnsatCores_ && result == INCOHERENT )
     {        
         if( unsatCore == NULL )
-            unsatCore = new Clause();
+            unsatCore = Clause::create();
         else
         {
             if( minimizeUnsatCore_ )
@@ -757,6 +806,7 @@ Solver::addVariableInternal()
     heuristic->onNewVariable( variables.numberOfVariables() );
     learning.onNewVariable();
     glucoseData.onNewVariable();
+    phases.onNewVariable();
     
     variableDataStructures.push_back( new DataStructures() );
     variableDataStructures.push_back( new DataStructures() );
@@ -812,6 +862,8 @@ Solver::assignLiteral(
         conflictLiteral = literal;
         conflictClause = NULL; 
     }
+    else if( events.isSubscribed( literal.getVariable() ) )
+        events.onAssigned( literal );
 }
 
 void
@@ -825,6 +877,8 @@ Solver::assignLiteral(
         conflictLiteral = implicant->getAt( 0 );
         conflictClause = implicant;        
     }
+    else if( events.isSubscribed( implicant->getAt( 0 ).getVariable() ) )
+        events.onAssigned( implicant->getAt( 0 ) );
 }
 
 void
@@ -840,6 +894,8 @@ Solver::assignLiteral(
         conflictLiteral = lit;
         conflictClause = implicant;        
     }
+    else if( events.isSubscribed( lit.getVariable() ) )
+        events.onAssigned( lit );
 }
 
 bool
@@ -1010,6 +1066,20 @@ Solver::addBinaryClause(
     addLiteralInShortClause( lit2, lit1 );
 }
 
+void
+Solver::addTernaryClause(
+    Literal lit1,
+    Literal lit2,
+    Literal lit3 )
+{
+    TernaryImplication implication1 = { lit2, lit3 };
+    TernaryImplication implication2 = { lit1, lit3 };
+    TernaryImplication implication3 = { lit1, lit2 };
+    getDataStructure( lit1 ).variableTernaryClauses.push_back( implication1 );
+    getDataStructure( lit2 ).variableTernaryClauses.push_back( implication2 );
+    getDataStructure( lit3 ).variableTernaryClauses.push_back( implication3 );
+}
+
 bool
 Solver::addClause(
     Clause* clause )
@@ -1097,10 +1167,43 @@ Solver::incrementCurrentDecisionLevel()
     assert( currentDecisionLevel == unrollVector.size() );
 }
 
+Literal
+Solver::getChoiceLiteral(
+    Var v ) const
+{
+    TruthValue value = phases.isEnabled() ? phases.getTargetPhase( v ) : UNDEFINED;
+    if( value == UNDEFINED )
+        value = getCachedTruthValue( v );
+    if( value == UNDEFINED )
+        value = phases.getInitialPhase( v );
+    return value == TRUE ? Literal( v, POSITIVE ) : Literal( v, NEGATIVE );
+}
+
 void
 Solver::unrollLastVariable()
 {    
-    heuristic->onUnrollingVariable( variables.unrollLastVariable() );
+    Var v = variables.unrollLastVariable();
+    heuristic->onUnrollingVariable( v );
+    if( events.isSubscribed( v ) )
+        events.onUnrolling( v );
+}
+
+void
+Solver::subscribe(
+    SolverListener* listener,
+    Var v )
+{
+    if( isUndefined( v ) )
+    {
+        events.subscribe( listener, v );
+        return;
+    }
+
+    // the listeners already subscribed get the pending assignments without this one
+    assert( getDecisionLevel( v ) == 0 );
+    events.notifyAssigned();
+    events.subscribe( listener, v );
+    listener->onAssigned( vector< Literal >( 1, isTrue( v ) ? Literal( v, POSITIVE ) : Literal( v, NEGATIVE ) ) );
 }
 
 void
@@ -1122,7 +1225,7 @@ Solver::doRestart()
         unroll( numberOfAssumptions );
     else
         unroll( 0 );
-        
+    events.onRestart();
 
     if( generator && exchangeClauses_ )
     {
@@ -1275,6 +1378,7 @@ Solver::chooseLiteral(
     
     if( choice != Literal::null )
         goto end;    
+    events.notifyAssigned();
     choice = heuristic->makeAChoice();
 
     if(choice== Literal::null)
@@ -1291,14 +1395,12 @@ bool
 Solver::analyzeConflict()
 {
     conflicts++;
-    conflictsRestarts++;
+    events.onConflict();
     
-    if( glucoseHeuristic_ )
-    {
-        glucoseData.trailQueue.push( numberOfAssignedLiterals() );
-        if( conflictsRestarts > 10000 && glucoseData.lbdQueue.isValid() && numberOfAssignedLiterals() /*trail.size()*/ > glucoseData.R * glucoseData.trailQueue.getAvg() )
-            glucoseData.lbdQueue.fastClear();
-    }    
+    if( phases.isEnabled() && currentDecisionLevel > 0 )
+        phases.onConflictFreeTrail( variables, unrollVector.back() );
+
+    restart->onConflict( numberOfAssignedLiterals() );
 
     Clause* learnedClause = learning.onConflict( conflictLiteral, conflictClause );
     assert( "Learned clause has not been calculated." && learnedClause != NULL );
@@ -1339,11 +1441,7 @@ Solver::analyzeConflict()
     }
     else
     {
-        if( glucoseHeuristic_ )
-        {
-            glucoseData.sumLBD += learnedClause->lbd();
-            glucoseData.lbdQueue.push( learnedClause->lbd() );
-        }
+        restart->onLearnedClause( learnedClause->lbd() );
         
         Literal firstLiteral = learnedClause->getAt( 0 );
         Literal secondLiteral = learnedClause->getAt( 1 );
@@ -1354,8 +1452,19 @@ Solver::analyzeConflict()
         unsigned int unrollLevel = getDecisionLevel( secondLiteral );
         assert_msg( unrollLevel != 0, "Trying to backjumping to level 0" );
         assert_msg( unrollLevel < currentDecisionLevel, "Trying to backjump from level " << unrollLevel << " to level " << currentDecisionLevel );
-        trace_msg( solving, 2, "Learned clause and backjumping to level " << unrollLevel );
         addLearnedClause( learnedClause, true );        
+        
+        if( currentDecisionLevel - unrollLevel > wasp::Options::chronoBacktrackingThreshold )
+        {
+            /*
+             * Chronological backtracking: the trail is kept up to the previous level
+             * and the UIP is assigned there, even if it is implied at a lower level.
+             * The trail remains ordered by decision level, so propagators are reset as usual.
+             */
+            unrollLevel = currentDecisionLevel - 1;
+            statistics( this, onChronologicalBacktracking() );
+        }
+        trace_msg( solving, 2, "Learned clause and backjumping to level " << unrollLevel );
 
         unroll( unrollLevel );
         clearConflictStatus();                        
@@ -1539,6 +1648,11 @@ Solver::attachWatches()
                 addBinaryClause( current[ 0 ], current[ 1 ] );        
                 deleteClause( currentPointer );
             }
+            else if( current.size() == 3 && current.canBeDeleted() )
+            {
+                addTernaryClause( current[ 0 ], current[ 1 ], current[ 2 ] );
+                deleteClause( currentPointer );
+            }
             else
             {
                 literalsInClauses += current.size();
@@ -1713,7 +1827,7 @@ Solver::newClause(
 //    Clause* back = poolOfClauses.back();
 //    poolOfClauses.pop_back();
 //    return back;
-    return new Clause( reserve );
+    return Clause::create( reserve );
 }
 
 void
@@ -1758,6 +1872,9 @@ Solver::propagate(
     shortPropagation( variable );
     if( conflictDetected() )    
         return;    
+    ternaryPropagation( variable );
+    if( conflictDetected() )
+        return;
     unitPropagation( variable );
 }
 
@@ -1898,8 +2015,8 @@ Solver::attachClause(
     Clause& clause )
 {
     assert_msg( clause.size() > 1, "Clause " << clause << " is unary and it must be removed" );
-    addWatchedClause( clause[ 0 ], &clause );
-    addWatchedClause( clause[ 1 ], &clause );    
+    addWatchedClause( clause[ 0 ], &clause, clause[ 1 ] );
+    addWatchedClause( clause[ 1 ], &clause, clause[ 0 ] );
 }
 
 void
@@ -1907,7 +2024,7 @@ Solver::attachSecondWatch(
     Clause& clause )
 {
     assert_msg( clause.size() > 1, "Clause " << clause << " is unary and it must be removed" );
-    addWatchedClause( clause[ 1 ], &clause );    
+    addWatchedClause( clause[ 1 ], &clause, clause[ 0 ] );
 }
 
 void
@@ -2149,9 +2266,6 @@ Solver::removeSatisfiedLiterals(
         return true;        
     }
     
-    assert_msg( !isFalse( clause[ 0 ] ), "Literal " << clause[ 0 ] <<  " in clause " << clause << " is false" );
-    assert_msg( !isFalse( clause[ 1 ] ), "Literal " << clause[ 1 ] <<  " in clause " << clause << " is false" );
-
     if( isTrue( clause[ 1 ] ) )
         return true;        
     
@@ -2162,7 +2276,7 @@ Solver::removeSatisfiedLiterals(
 
         if( isFalse( clause[ i ] ) )
         {
-            clause[ i ] = clause[ clause.size() - 1 ];
+            clause.setAt( i, clause[ clause.size() - 1 ] );
             clause.removeLastLiteralNoWatches();            
         }
         else
@@ -2170,6 +2284,10 @@ Solver::removeSatisfiedLiterals(
             i++;
         }        
     }
+
+    //A watched literal can be false only if the clause is satisfied by its blocker.
+    assert_msg( !isFalse( clause[ 0 ] ), "Literal " << clause[ 0 ] <<  " in clause " << clause << " is false" );
+    assert_msg( !isFalse( clause[ 1 ] ), "Literal " << clause[ 1 ] <<  " in clause " << clause << " is false" );
         
     return false;
 }
@@ -2185,8 +2303,8 @@ Solver::onLiteralFalse(
     if( literal == clause[ 0 ] )
     {
         //The watch to update should be always in position 1.
-        clause[ 0 ] = clause[ 1 ];
-        clause[ 1 ] = literal;
+        clause.setAt( 0, clause[ 1 ] );
+        clause.setAt( 1, literal );
     }
 
     assert_msg( literal == clause[ 1 ], "Literal " << literal << " should be in position 1, but literal " << clause[ 1 ] << "is in position 1" );
@@ -2220,7 +2338,8 @@ Solver::learnedClauseUsedForConflict(
     if( glucoseHeuristic_ )
     {
         Clause& clause = *clausePointer;
-        if( clause.lbd() > 2 )
+        clause.setUsed( true );
+        if( clause.tier() != CORE_TIER )
         {
             unsigned lbd = computeLBD( clause );
             if( lbd + 1 < clause.lbd() )
@@ -2231,6 +2350,10 @@ Solver::learnedClauseUsedForConflict(
                 }
                 clause.setLbd( lbd );
             }
+            
+            unsigned int tier = computeTier( lbd );
+            if( tier < clause.tier() )
+                clause.setTier( tier );
         }
     }
 }
@@ -2281,14 +2404,19 @@ Solver::restartIfNecessary()
 {
     if( currentDecisionLevel == 0 )
         return true;
-    bool hasToRestart = glucoseHeuristic_ ? ( glucoseData.lbdQueue.isValid() && ( ( glucoseData.lbdQueue.getAvg() * glucoseData.K ) > ( glucoseData.sumLBD / conflictsRestarts ) ) ) : restart->hasToRestart();
-    if( hasToRestart )
+    if( restart->hasToRestart() )
     {
     	heuristic->conflictOccurred( );
     	statistics( this, onRestart() );
-        glucoseData.lbdQueue.fastClear();
         if( !doRestart() )
             return false;
+        heuristic->onRestart();
+        if( phases.hasToRephase( conflicts ) )
+        {
+            trace_msg( solving, 2, "Rephasing" );
+            phases.rephase( variables, conflicts );
+            statistics( this, onRephase() );
+        }
         simplifyOnRestart();
     }
     
@@ -2327,9 +2455,7 @@ Solver::minimisationWithBinaryResolution(
             {
                 if( glucoseData.permDiff[ learnedClause[ i ].getVariable() ] != glucoseData.MYFLAG )
                 {
-                    Literal p = learnedClause[ l ];
-                    learnedClause[ l ] = learnedClause[ i ];
-                    learnedClause[ i ] = p;
+                    learnedClause.swapLiteralsNoWatches( l, i );
                     l--;
                     i--;
                 }
@@ -2459,7 +2585,7 @@ Solver::minimizeUnsatCore(
     assert( result == INCOHERENT );
     
     if( unsatCore == NULL )
-        unsatCore = new Clause();
+        unsatCore = Clause::create();
     
     assert( unsatCore->size() <= oldSize );
     if( unsatCore->size() < oldSize )
@@ -0,0 +1,166 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+#ifndef SOLVEREVENTS_H
+#define SOLVEREVENTS_H
+
+#include <cassert>
+#include <vector>
+
+#include "Literal.h"
+#include "SolverListener.h"
+#include "util/Assert.h"
+#include "util/ErrorMessage.h"
+
+using namespace std;
+
+/*
+ * Dispatches the events of the solver to the subscribed listeners.
+ *
+ * Each variable has a bitmap of the listeners subscribed to it, hence the
+ * solver pays a single test for the variables without listeners (and nothing
+ * else if there are no subscriptions at all). Assignments are buffered and
+ * notified in one batch per propagation round; the buffered assignments that
+ * are unrolled before the notification are dropped, since the buffer is a
+ * suffix of the trail.
+ */
+class SolverEvents
+{
+    public:
+        static const unsigned int MAX_LISTENERS = 32;
+
+        inline SolverEvents() {}
+
+        inline void subscribe( SolverListener* listener, Var variable );
+        inline void subscribeConflicts( SolverListener* listener ) { conflictListeners.push_back( listener ); }
+        inline void subscribeRestarts( SolverListener* listener ) { restartListeners.push_back( listener ); }
+
+        inline bool isSubscribed( Var variable ) const { return variable < masks.size() && masks[ variable ] != 0; }
+
+        inline void onAssigned( Literal literal ) { assert( isSubscribed( literal.getVariable() ) ); assigned.push_back( literal ); }
+        inline void onUnrolling( Var variable );
+        inline void onConflict();
+        inline void onRestart();
+
+        /**
+         * Notifies the buffered assignments.
+         */
+        inline void notifyAssigned() { if( !assigned.empty() ) notify( assigned, assignedBatch ); }
+
+        /**
+         * Notifies the variables unrolled since the last call.
+         */
+        inline void notifyUnassigned() { if( !unassigned.empty() ) notify( unassigned, unassignedBatch ); }
+
+    private:
+        inline unsigned int getListener( SolverListener* listener );
+        template< class T > inline void notify( vector< T >& events, vector< T >& batch );
+        inline Var getVariable( Literal literal ) const { return literal.getVariable(); }
+        inline Var getVariable( Var variable ) const { return variable; }
+        inline void notify( SolverListener* listener, const vector< Literal >& literals ) { listener->onAssigned( literals ); }
+        inline void notify( SolverListener* listener, const vector< Var >& variables ) { listener->onUnassigned( variables ); }
+
+        vector< SolverListener* > listeners;
+        vector< unsigned int > masks;
+        vector< SolverListener* > conflictListeners;
+        vector< SolverListener* > restartListeners;
+
+        vector< Literal > assigned;
+        vector< Var > unassigned;
+
+        // the events of a single listener, when there are several
+        vector< Literal > assignedBatch;
+        vector< Var > unassignedBatch;
+};
+
+unsigned int
+SolverEvents::getListener(
+    SolverListener* listener )
+{
+    for( unsigned int i = 0; i < listeners.size(); i++ )
+        if( listeners[ i ] == listener )
+            return i;
+
+    // the listeners of a variable are the bits of its mask
+    if( listeners.size() >= MAX_LISTENERS )
+        ErrorMessage::errorGeneric( "Too many solver listeners" );
+    listeners.push_back( listener );
+    return listeners.size() - 1;
+}
+
+void
+SolverEvents::subscribe(
+    SolverListener* listener,
+    Var variable )
+{
+    unsigned int id = getListener( listener );
+    if( variable >= masks.size() )
+        masks.resize( variable + 1, 0 );
+    masks[ variable ] |= 1u << id;
+}
+
+void
+SolverEvents::onUnrolling(
+    Var variable )
+{
+    assert( isSubscribed( variable ) );
+    if( !assigned.empty() && assigned.back().getVariable() == variable )
+        assigned.pop_back();
+    else
+        unassigned.push_back( variable );
+}
+
+void
+SolverEvents::onConflict()
+{
+    for( unsigned int i = 0; i < conflictListeners.size(); i++ )
+        conflictListeners[ i ]->onConflict();
+}
+
+void
+SolverEvents::onRestart()
+{
+    for( unsigned int i = 0; i < restartListeners.size(); i++ )
+        restartListeners[ i ]->onRestart();
+}
+
+template< class T >
+void
+SolverEvents::notify(
+    vector< T >& events,
+    vector< T >& batch )
+{
+    if( listeners.size() == 1 )
+    {
+        notify( listeners[ 0 ], events );
+        events.clear();
+        return;
+    }
+
+    for( unsigned int i = 0; i < listeners.size(); i++ )
+    {
+        batch.clear();
+        for( unsigned int j = 0; j < events.size(); j++ )
+            if( masks[ getVariable( events[ j ] ) ] & ( 1u << i ) )
+                batch.push_back( events[ j ] );
+        if( !batch.empty() )
+            notify( listeners[ i ], batch );
+    }
+    events.clear();
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+#ifndef SOLVERLISTENER_H
+#define SOLVERLISTENER_H
+
+#include <vector>
+
+#include "Literal.h"
+
+using namespace std;
+
+/*
+ * A component notified of the events of the solver it subscribed to through
+ * Solver::subscribe, Solver::subscribeConflicts and Solver::subscribeRestarts.
+ * Listeners must not change the state of the solver while they are notified.
+ */
+class SolverListener
+{
+    public:
+        virtual ~SolverListener() {}
+
+        /**
+         * The subscribed variables assigned since the last notification, in the
+         * order of the trail, as the literals made true. The assignments are
+         * notified once propagation is over, before the next choice; those
+         * unrolled before are never notified.
+         */
+        virtual void onAssigned( const vector< Literal >& ) {}
+
+        /**
+         * The subscribed variables unrolled by a backjump, in reverse order of the
+         * trail. Only variables whose assignment has been notified are notified.
+         */
+        virtual void onUnassigned( const vector< Var >& ) {}
+
+        /**
+         * A conflict is going to be analyzed.
+         */
+        virtual void onConflict() {}
+
+        /**
+         * Called after each restart, once the solver has unrolled the choices.
+         */
+        virtual void onRestart() {}
+};
+
+#endif
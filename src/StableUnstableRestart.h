@@ -0,0 +1,83 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef STABLEUNSTABLERESTART_H
+#define STABLEUNSTABLERESTART_H
+
+#include <cstdint>
+
+#include "Restart.h"
+#include "EmaRestart.h"
+#include "LubyRestart.h"
+
+/*
+ * Alternates an unstable mode, with the frequent dynamic restarts of
+ * EmaRestart, and a stable mode, with rare restarts following the Luby
+ * sequence. The search starts in unstable mode; every mode lasts twice the
+ * conflicts of the previous one, and a restart is performed on every switch.
+ */
+class StableUnstableRestart : public Restart
+{
+    public:
+        inline StableUnstableRestart( unsigned int firstModeLength = 1000 );
+
+        inline void onConflict( unsigned int trailSize );
+        void onLearnedClause( unsigned int lbd ) { unstable.onLearnedClause( lbd ); }
+        inline bool hasToRestart();
+        void onRestart() { unstable.onRestart(); stable.onRestart(); }
+        Restart* clone() const { return new StableUnstableRestart( firstModeLength ); }
+
+    private:
+        EmaRestart unstable;
+        LubyRestart stable;
+
+        unsigned int firstModeLength;
+        uint64_t modeLength;
+        uint64_t conflictsInMode;
+        bool stableMode;
+};
+
+StableUnstableRestart::StableUnstableRestart(
+    unsigned int length ) : stable( 1024, true ), firstModeLength( length ), modeLength( length ), conflictsInMode( 0 ), stableMode( false )
+{
+}
+
+void
+StableUnstableRestart::onConflict(
+    unsigned int trailSize )
+{
+    conflictsInMode++;
+    unstable.onConflict( trailSize );
+    stable.onConflict( trailSize );
+}
+
+bool
+StableUnstableRestart::hasToRestart()
+{
+    if( conflictsInMode >= modeLength )
+    {
+        stableMode = !stableMode;
+        conflictsInMode = 0;
+        modeLength *= 2;
+        return true;
+    }
+
+    return stableMode ? stable.hasToRestart() : unstable.hasToRestart();
+}
+
+#endif
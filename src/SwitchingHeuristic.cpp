@@ -0,0 +1,123 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "SwitchingHeuristic.h"
+#include "Solver.h"
+
+SwitchingHeuristic::SwitchingHeuristic(
+    Solver& s,
+    unsigned int firstPhaseLength ) : Heuristic( s ), vmtfMode( true ), phaseLength( firstPhaseLength ), nextSwitch( firstPhaseLength )
+{
+    vsids = new MinisatHeuristic( s );
+    vmtf = new VMTFHeuristic( s );
+}
+
+SwitchingHeuristic::~SwitchingHeuristic()
+{
+    delete vsids;
+    delete vmtf;
+}
+
+void
+SwitchingHeuristic::onNewVariable(
+    Var v )
+{
+    vsids->onNewVariable( v );
+    vmtf->onNewVariable( v );
+}
+
+void
+SwitchingHeuristic::onNewVariableRuntime(
+    Var v )
+{
+    vsids->onNewVariableRuntime( v );
+    vmtf->onNewVariableRuntime( v );
+}
+
+void
+SwitchingHeuristic::onLiteralInvolvedInConflict(
+    Literal literal )
+{
+    if( vmtfMode )
+        vmtf->onLiteralInvolvedInConflict( literal );
+    else
+        vsids->onLiteralInvolvedInConflict( literal );
+}
+
+void
+SwitchingHeuristic::onUnrollingVariable(
+    Var var )
+{
+    if( vmtfMode )
+        vmtf->onUnrollingVariable( var );
+    else
+        vsids->onUnrollingVariable( var );
+}
+
+void
+SwitchingHeuristic::incrementHeuristicValues(
+    Var v )
+{
+    if( vmtfMode )
+        vmtf->incrementHeuristicValues( v );
+    else
+        vsids->incrementHeuristicValues( v );
+}
+
+void
+SwitchingHeuristic::simplifyVariablesAtLevelZero()
+{
+    vsids->simplifyVariablesAtLevelZero();
+    vmtf->simplifyVariablesAtLevelZero();
+}
+
+void
+SwitchingHeuristic::conflictOccurred()
+{
+    if( vmtfMode )
+        vmtf->conflictOccurred();
+    else
+        vsids->conflictOccurred();
+}
+
+void
+SwitchingHeuristic::onRestart()
+{
+    if( solver.getNumberOfConflicts() >= nextSwitch )
+        switchMode();
+}
+
+void
+SwitchingHeuristic::switchMode()
+{
+    vmtfMode = !vmtfMode;
+    trace_msg( heuristic, 1, "Switching to " << ( vmtfMode ? "VMTF" : "VSIDS" ) );
+    if( vmtfMode )
+        vmtf->resetSearch();
+    else
+        vsids->refillHeap();
+
+    phaseLength *= 2;
+    nextSwitch = solver.getNumberOfConflicts() + phaseLength;
+}
+
+Literal
+SwitchingHeuristic::makeAChoiceProtected()
+{
+    return vmtfMode ? vmtf->makeAChoice() : vsids->makeAChoice();
+}
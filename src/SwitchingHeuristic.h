@@ -0,0 +1,68 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef SWITCHINGHEURISTIC_H
+#define SWITCHINGHEURISTIC_H
+
+#include "Heuristic.h"
+#include "MinisatHeuristic.h"
+#include "VMTFHeuristic.h"
+
+#include <cstdint>
+class Solver;
+
+/**
+ * Alternates VMTF and VSIDS in phases of conflicts. The search starts with
+ * VMTF, and the mode is switched in onRestart, at the first restart after
+ * the current phase is over; the length of each phase doubles. Only the
+ * active heuristic is notified of bumps and unrolls, so the VSIDS heap is
+ * not maintained during the VMTF phases.
+ */
+class SwitchingHeuristic : public Heuristic
+{
+    public:
+        SwitchingHeuristic( Solver& s, unsigned int firstPhaseLength );
+        ~SwitchingHeuristic();
+
+        void onNewVariable( Var v );
+        void onNewVariableRuntime( Var v );
+        inline void onFinishedParsing ( ) { };
+        void onLiteralInvolvedInConflict( Literal literal );
+        void onUnrollingVariable( Var var );
+        void incrementHeuristicValues( Var v );
+        void simplifyVariablesAtLevelZero();
+        void conflictOccurred();
+        unsigned int getTreshold( ){ return 0; };
+        void onFinishedSolving( ) { };
+        void onRestart();
+
+    protected:
+        virtual Literal makeAChoiceProtected();
+
+    private:
+        void switchMode();
+
+        MinisatHeuristic* vsids;
+        VMTFHeuristic* vmtf;
+        bool vmtfMode;
+
+        uint64_t phaseLength;
+        uint64_t nextSwitch;
+};
+
+#endif
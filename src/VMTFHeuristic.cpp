@@ -0,0 +1,108 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "VMTFHeuristic.h"
+
+#include <algorithm>
+#include <cassert>
+#include "Literal.h"
+#include "Solver.h"
+
+struct StampComparator
+{
+    const Vector< uint64_t >& stamps;
+    bool operator()( Var x, Var y ) const { return stamps[ x ] < stamps[ y ]; }
+    StampComparator( const Vector< uint64_t >& s ) : stamps( s ) {}
+};
+
+Literal
+VMTFHeuristic::makeAChoiceProtected()
+{
+    trace_msg( heuristic, 1, "Starting VMTF heuristic" );
+    bumpVariables();
+
+    Var chosenVariable = searchPointer != 0 ? searchPointer : last;
+    while( !solver.isUndefined( chosenVariable ) )
+    {
+        chosenVariable = prev[ chosenVariable ];
+        assert_msg( chosenVariable != 0, "All the variables in the queue are assigned" );
+    }
+    searchPointer = chosenVariable;
+
+    assert_msg( solver.isUndefined( chosenVariable ), "The literal must be undefined" );
+    trace_msg( heuristic, 1, "Ending VMTF heuristic" );
+
+    return solver.getChoiceLiteral( chosenVariable );
+}
+
+void
+VMTFHeuristic::bumpVariables()
+{
+    if( toBump.empty() )
+        return;
+
+    //Moving the variables in the order of their timestamps preserves their relative order
+    sort( toBump.begin(), toBump.end(), StampComparator( stamps ) );
+    for( unsigned int i = 0; i < toBump.size(); i++ )
+    {
+        Var v = toBump[ i ];
+        toBumpFlags[ v ] = false;
+        if( !solver.isUndefined( v ) && solver.getDecisionLevel( v ) == 0 )
+            continue;
+
+        trace_msg( heuristic, 2, "Moving variable " << v << " to the front" );
+        if( searchPointer == v )
+            searchPointer = prev[ v ];
+        dequeue( v );
+        enqueue( v );
+        if( solver.isUndefined( v ) )
+            searchPointer = v;
+    }
+    toBump.clear();
+}
+
+void
+VMTFHeuristic::onNewVariableRuntime(
+    Var v )
+{
+    assert( prev.size() - 1 == v );
+    enqueue( v );
+    if( solver.isUndefined( v ) )
+        searchPointer = v;
+}
+
+void
+VMTFHeuristic::simplifyVariablesAtLevelZero()
+{
+    first = last = searchPointer = 0;
+    for( unsigned int i = 0; i < vars.size(); )
+    {
+        if( !solver.isUndefined( vars[ i ] ) )
+        {
+            assert_msg( solver.getDecisionLevel( vars[ i ] ) == 0, "Variable " << vars[ i ] << " has not been inferred at level 0.");
+            vars[ i ] = vars.back();
+            vars.pop_back();
+        }
+        else
+        {
+            enqueue( vars[ i ] );
+            ++i;
+        }
+    }
+    searchPointer = last;
+}
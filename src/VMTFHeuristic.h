@@ -0,0 +1,155 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef VMTFHEURISTIC_H
+#define VMTFHEURISTIC_H
+
+#include "util/Trace.h"
+#include "Literal.h"
+#include "stl/Vector.h"
+#include "Heuristic.h"
+
+#include <cassert>
+#include <iostream>
+using namespace std;
+class Solver;
+
+/**
+ * Variable-move-to-front heuristic.
+ *
+ * Variables are kept in a doubly linked queue ordered by the timestamp of
+ * their last enqueueing. The variables involved in a conflict are moved to
+ * the end of the queue, and choices are taken by walking the queue backward
+ * from a cached search pointer. All the variables after the search pointer
+ * are assigned, so unrolling a variable only compares two timestamps.
+ */
+class VMTFHeuristic : public Heuristic
+{
+    public:
+        inline VMTFHeuristic( Solver& s );
+        inline ~VMTFHeuristic(){};
+
+        inline void onNewVariable( Var v );
+        void onNewVariableRuntime( Var v );
+        inline void onFinishedParsing ( ) { };
+        inline void onLiteralInvolvedInConflict( Literal literal ) { addToBump( literal.getVariable() ); }
+        inline void onUnrollingVariable( Var var );
+        inline void incrementHeuristicValues( Var v ) { addToBump( v ); }
+        void simplifyVariablesAtLevelZero();
+        inline void conflictOccurred() {}
+        unsigned int getTreshold( ){ return 0; };
+        void onFinishedSolving( ) { };
+
+        /**
+         * Restarts the search from the end of the queue. It is used when
+         * the unrolled variables have not been notified to this heuristic.
+         */
+        inline void resetSearch() { searchPointer = last; }
+
+    protected:
+        virtual Literal makeAChoiceProtected();
+
+    private:
+        inline void addToBump( Var v );
+        void bumpVariables();
+        inline void enqueue( Var v );
+        inline void dequeue( Var v );
+
+        Vector< Var > prev;
+        Vector< Var > next;
+        Vector< uint64_t > stamps;
+        Vector< bool > toBumpFlags;
+
+        vector< Var > vars;
+        vector< Var > toBump;
+
+        Var first;
+        Var last;
+        Var searchPointer;
+        uint64_t stamp;
+};
+
+VMTFHeuristic::VMTFHeuristic( Solver& s ) :
+    Heuristic( s ), first( 0 ), last( 0 ), searchPointer( 0 ), stamp( 0 )
+{
+    prev.push_back( 0 );
+    next.push_back( 0 );
+    stamps.push_back( 0 );
+    toBumpFlags.push_back( false );
+}
+
+void
+VMTFHeuristic::onNewVariable(
+    Var v )
+{
+    assert( prev.size() == v );
+    prev.push_back( 0 );
+    next.push_back( 0 );
+    stamps.push_back( 0 );
+    toBumpFlags.push_back( false );
+    vars.push_back( v );
+}
+
+void
+VMTFHeuristic::onUnrollingVariable(
+    Var variable )
+{
+    if( stamps[ variable ] > stamps[ searchPointer ] )
+        searchPointer = variable;
+}
+
+void
+VMTFHeuristic::addToBump(
+    Var v )
+{
+    if( toBumpFlags[ v ] )
+        return;
+    toBumpFlags[ v ] = true;
+    toBump.push_back( v );
+}
+
+void
+VMTFHeuristic::enqueue(
+    Var v )
+{
+    prev[ v ] = last;
+    next[ v ] = 0;
+    if( last != 0 )
+        next[ last ] = v;
+    else
+        first = v;
+    last = v;
+    stamps[ v ] = ++stamp;
+}
+
+void
+VMTFHeuristic::dequeue(
+    Var v )
+{
+    if( prev[ v ] != 0 )
+        next[ prev[ v ] ] = next[ v ];
+    else
+        first = next[ v ];
+
+    if( next[ v ] != 0 )
+        prev[ next[ v ] ] = prev[ v ];
+    else
+        last = prev[ v ];
+}
+
+#endif
@@ -27,20 +27,36 @@
 #include "util/VariableNames.h"
 #include "stl/Vector.h"
 #include "ReasonForBinaryClauses.h"
+#include "ReasonForTernaryClauses.h"
+#include "Clause.h"
 
 using namespace std;
 class Component;
 class HCComponent;
 class Reason;
 
+/**
+ * Data written by Variables::assign and read by conflict analysis.
+ * The decision level and the 32-bit reference of the implicant (see Reason)
+ * share one record, so that both are loaded with a single cache line.
+ */
+struct VariableState
+{
+    unsigned int decisionLevel;
+    unsigned int implicant;
+};
+
+/**
+ * Data that is not touched by propagation and conflict analysis.
+ * Truth values and states are kept in separate arrays of Variables, so
+ * that assigning a variable or walking the implication graph does not load
+ * the fields below.
+ */
 struct VariableData
 {
-    Reason* implicant;
     Component* component;
     HCComponent* hcComponent;
-    ReasonForBinaryClauses* reasonForBinaryClauses;
     
-    unsigned int decisionLevel : 27;
     unsigned int isAssumptionAND : 1;
     unsigned int isAssumptionOR : 1;
     unsigned int frozen : 1;
@@ -104,19 +120,20 @@ class Variables
         
         inline TruthValue getTruthValue( Var v ) const { return assigns[ v ] & UNROLL_MASK; }
         inline TruthValue getCachedTruthValue( Var v ) const { return assigns[ v ] >> UNROLL_MASK; }
+        inline void setCachedTruthValue( Var v, TruthValue truth ) { assert( isUndefined( v ) && truth != UNDEFINED ); assigns[ v ] = truth == TRUE ? CACHE_TRUE : CACHE_FALSE; }
         
         inline bool setTrue( Literal lit );        
         
-        inline bool isImplicant( Var v, const Clause* clause ) const { return !isUndefined( v ) && variablesData[ v ].implicant == clause; }
-        inline bool hasImplicant( Var v ) const { return variablesData[ v ].implicant != NULL; }
-        inline void setImplicant( Var v, Reason* clause ) { variablesData[ v ].implicant = clause; }
-        inline Reason* getImplicant( Var v ) { return variablesData[ v ].implicant; }
+        inline bool isImplicant( Var v, const Clause* clause ) const { return !isUndefined( v ) && states[ v ].implicant == clause->getRef(); }
+        inline bool hasImplicant( Var v ) const { return states[ v ].implicant != NO_CLAUSE; }
+        inline void setImplicant( Var v, Reason* clause ) { states[ v ].implicant = clause != NULL ? clause->getRef() : NO_CLAUSE; }
+        inline Reason* getImplicant( Var v ) const;
 
-        inline unsigned int getDecisionLevel( Var v ) const { return variablesData[ v ].decisionLevel; }
+        inline unsigned int getDecisionLevel( Var v ) const { return states[ v ].decisionLevel; }
         inline unsigned int getDecisionLevel( Literal lit ) const { return getDecisionLevel( lit.getVariable() ); }
-        inline void setDecisionLevel( Var v, unsigned int decisionLevel ) { variablesData[ v ].decisionLevel = decisionLevel; }
+        inline void setDecisionLevel( Var v, unsigned int decisionLevel ) { states[ v ].decisionLevel = decisionLevel; }
         
-        inline const Clause* getDefinition( Var v ) const { return ( Clause* ) variablesData[ v ].implicant; }
+        inline Clause* getDefinition( Var v ) const { return states[ v ].implicant != NO_CLAUSE ? Clause::get( states[ v ].implicant ) : NULL; }
         inline void setEliminated( Var v, unsigned int value, Clause* definition );
         inline unsigned int getSignOfEliminatedVariable( Var v ) const { return variablesData[ v ].signOfEliminatedVariable; }
         inline bool hasBeenEliminated( Var v ) const { return variablesData[ v ].signOfEliminatedVariable != NOT_ELIMINATED; }
@@ -131,7 +148,8 @@ class Variables
         inline Component* getComponent( Var v ) { return variablesData[ v ].component; }
         inline HCComponent* getHCComponent( Var v ) { return variablesData[ v ].hcComponent; }
         
-        inline ReasonForBinaryClauses* getReasonForBinaryClauses( Var v ) { return variablesData[ v ].reasonForBinaryClauses; }
+        inline ReasonForBinaryClauses* getReasonForBinaryClauses( Var v ) { return reasonsForBinaryClauses[ v ]; }
+        inline ReasonForTernaryClauses* getReasonForTernaryClauses( Var v ) { return reasonsForTernaryClauses[ v ]; }
         
         inline bool isFrozen( Var v ) const { return variablesData[ v ].frozen; }
         inline void setFrozen( Var v ) { variablesData[ v ].frozen = 1; }
@@ -145,7 +163,10 @@ class Variables
     private:
         vector< Var > assignedVariables;
         Vector< TruthValue > assigns;
+        Vector< VariableState > states;
         
+        Vector< ReasonForBinaryClauses* > reasonsForBinaryClauses;
+        Vector< ReasonForTernaryClauses* > reasonsForTernaryClauses;
         Vector< VariableData > variablesData;
         unsigned assignedVariablesSize;
         int iteratorOnAssignedVariables;
@@ -165,6 +186,10 @@ Variables::Variables()
     numOfVariables( 1 )
 {  
     assigns.push_back( UNDEFINED );
+    VariableState state = { 0, NO_CLAUSE };
+    states.push_back( state );
+    reasonsForBinaryClauses.push_back( NULL );
+    reasonsForTernaryClauses.push_back( NULL );
     variablesData.push_back( VariableData() );    
 }
 
@@ -173,8 +198,9 @@ Variables::~Variables()
     for( unsigned int i = 1; i < numOfVariables; i++ )
     {
         if( hasBeenEliminated( i ) && !hasBeenEliminatedByDistribution( i ) )
-            delete variablesData[ i ].implicant;
-        delete variablesData[ i ].reasonForBinaryClauses;
+            delete getDefinition( i );
+        delete reasonsForBinaryClauses[ i ];
+        delete reasonsForTernaryClauses[ i ];
     }
 }
 
@@ -186,16 +212,18 @@ Variables::push_back()
     variablesData.push_back( VariableData() );
     
     VariableData& vd = variablesData.back();
-    vd.implicant = NULL;
-    vd.decisionLevel = 0;
     vd.component = NULL;
+    vd.hcComponent = NULL;
     vd.signOfEliminatedVariable = NOT_ELIMINATED;
     vd.frozen = 0;
     vd.isAssumptionAND = 0;
     vd.isAssumptionOR = 0;    
-    vd.reasonForBinaryClauses = new ReasonForBinaryClauses( variablesData.size() - 1 );
     
     assigns.push_back( UNDEFINED );
+    VariableState state = { 0, NO_CLAUSE };
+    states.push_back( state );
+    reasonsForBinaryClauses.push_back( new ReasonForBinaryClauses( variablesData.size() - 1 ) );
+    reasonsForTernaryClauses.push_back( new ReasonForTernaryClauses() );
 }
 
 Var
@@ -263,6 +291,16 @@ Variables::printAnswerSet(
     outputBuilder->endModel();
 }
 
+Reason*
+Variables::getImplicant(
+    Var v ) const
+{
+    unsigned int ref = states[ v ].implicant;
+    if( ref & Reason::REGISTERED )
+        return Reason::getRegistered( ref );
+    return ref != NO_CLAUSE ? Clause::get( ref ) : NULL;
+}
+
 bool
 Variables::assign( 
     int level, 
@@ -378,7 +416,7 @@ Variables::setEliminated(
     assert_msg( value <= 2, "The sign must be 0 or 1. Found value " << value );
     assert( def != NULL || value == ELIMINATED_BY_DISTRIBUTION );
     variablesData[ v ].signOfEliminatedVariable = value;
-    variablesData[ v ].implicant = def;
+    states[ v ].implicant = def != NULL ? def->getRef() : NO_CLAUSE;
     
     #ifndef NDEBUG
     bool result = 
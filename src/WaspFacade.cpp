@@ -19,6 +19,10 @@
 #include "WaspFacade.h"
 
 #include "Restart.h"
+#include "LubyRestart.h"
+#include "GlucoseRestart.h"
+#include "EmaRestart.h"
+#include "StableUnstableRestart.h"
 
 #include "input/GringoNumericFormat.h"
 
@@ -29,10 +33,10 @@
 #include "outputBuilders/DimacsOutputBuilder.h"
 
 #include "MinisatHeuristic.h"
-#include "PUPHeuristic.h"
-#include "ColouringHeuristic.h"
-#include "BinPackingHeuristic.h"
+#include "VMTFHeuristic.h"
+#include "SwitchingHeuristic.h"
 #include "CombinedHeuristic.h"
+#include "HeuristicRegistry.h"
 #include "outputBuilders/MultiOutputBuilder.h"
 #include "QueryInterface.h"
 
@@ -200,15 +204,15 @@ WaspFacade::setDecisionPolicy(
 //            break;
         
         case HEURISTIC_PUP:
-            solver.setHeuristic( new PUPHeuristic( solver ) );
+            solver.setHeuristic( HeuristicRegistry::create( "pup", solver ) );
             break;
 
         case HEURISTIC_COLOURING:
-        	solver.setHeuristic( new ColouringHeuristic( solver ) );
+        	solver.setHeuristic( HeuristicRegistry::create( "colouring", solver ) );
         	break;
 
         case HEURISTIC_BINPACKING:
-        	solver.setHeuristic( new BinPackingHeuristic( solver ) );
+        	solver.setHeuristic( HeuristicRegistry::create( "binpacking", solver ) );
         	break;
 
         case HEURISTIC_COMBINED:
@@ -236,7 +240,7 @@ WaspFacade::setDecisionPolicy(
 					if ( !combined->addHeuristic( h ) )
 					{
 						found = false;
-						cout << "Can not find heuristic " << h << endl;
+						cout << "Can not find heuristic " << h << " ( available: " << HeuristicRegistry::getNames( ) << " )" << endl;
 					}
 				}
 
@@ -257,6 +261,14 @@ WaspFacade::setDecisionPolicy(
             solver.setHeuristic( new MinisatHeuristic( solver ) );
             solver.setMinisatHeuristic();
             break;
+
+        case HEURISTIC_VMTF:
+            solver.setHeuristic( new VMTFHeuristic( solver ) );
+            break;
+
+        case HEURISTIC_SWITCHING:
+            solver.setHeuristic( new SwitchingHeuristic( solver, wasp::Options::switchingHeuristicPhase ) );
+            break;
 //    
 //        default:
 //            heuristic->setDecisionStrategy( new BerkminHeuristic( solver, 512 ) );
@@ -303,18 +315,42 @@ WaspFacade::setRestartsPolicy(
     unsigned int threshold )
 {
     assert( threshold > 0 );
-    Restart* restart;
     switch( restartsPolicy )
     {
         case GEOMETRIC_RESTARTS_POLICY:
-            restart = new Restart( threshold, false );
-            solver.setRestart( restart );
-            break;            
+            solver.setRestart( new LubyRestart( threshold, false ) );
+            break;
+
+        case NO_RESTARTS_POLICY:
+            solver.setRestart( new NoRestart() );
+            break;
+
+        case EMA_RESTARTS_POLICY:
+            solver.setRestart( new EmaRestart() );
+            break;
+
+        case STABLE_UNSTABLE_RESTARTS_POLICY:
+            solver.setRestart( new StableUnstableRestart( threshold ) );
+            break;
+
+        case GLUCOSE_RESTARTS_POLICY:
+            if( solver.glucoseHeuristic() )
+            {
+                solver.setRestart( new GlucoseRestart() );
+                break;
+            }
+            //The minisat heuristic keeps its luby restarts.
+            solver.setRestart( new LubyRestart( threshold, true ) );
+            break;
+
+        case MINISAT_RESTARTS_POLICY:
+            //Geometric restarts with the increment of minisat.
+            solver.setRestart( new LubyRestart( threshold, false, 1.5 ) );
+            break;
 
         case SEQUENCE_BASED_RESTARTS_POLICY:
         default:
-            restart = new Restart( threshold, true );
-            solver.setRestart( restart );
+            solver.setRestart( new LubyRestart( threshold, true ) );
             break;
     }
 }
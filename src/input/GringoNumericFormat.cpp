@@ -8,6 +8,7 @@
 #include "../HCComponent.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <unordered_set>
 #include <bitset>
@@ -2782,7 +2783,7 @@ GringoNumericFormat::normalRuleToClause(
     NormalRule* normalRule )
 {
     trace_msg( parser, 3, "Converting normalRule " << *normalRule << " to clause" );
-    Clause* c = new Clause( normalRule->size() );
+    Clause* c = Clause::create( normalRule->size() );
     for( unsigned int i = 0; i < normalRule->size(); i++ )
         c->addLiteral( normalRule->literals[ i ] );
     return c;
@@ -38,6 +38,10 @@
 #define MINISAT_DELETION_POLICY 2
 #define GLUCOSE_DELETION_POLICY 3
 
+#define CORE_TIER 0
+#define TIER2 1
+#define LOCAL_TIER 2
+
 #define HEURISTIC_BERKMIN 0
 #define HEURISTIC_FIRST_UNDEFINED 1
 #define HEURISTIC_MINISAT 2
@@ -46,6 +50,8 @@
 #define HEURISTIC_COLOURING 5
 #define HEURISTIC_BINPACKING 6
 #define HEURISTIC_COMBINED 7
+#define HEURISTIC_VMTF 8
+#define HEURISTIC_SWITCHING 9
 
 #define WASP_OUTPUT 0
 #define COMPETITION_OUTPUT 1
@@ -58,6 +64,13 @@
 #define GEOMETRIC_RESTARTS_POLICY 1
 #define MINISAT_RESTARTS_POLICY 2
 #define NO_RESTARTS_POLICY 3
+#define GLUCOSE_RESTARTS_POLICY 4
+#define EMA_RESTARTS_POLICY 5
+#define STABLE_UNSTABLE_RESTARTS_POLICY 6
+
+#define BINPACKING_FIRST_FIT 0
+#define BINPACKING_BEST_FIT 1
+#define BINPACKING_WORST_FIT 2
 
 #define NO_QUERY 0
 #define OVERESTIMATE_REDUCTION 1
@@ -47,13 +47,16 @@ class Help
             cout << separator << endl;
             #endif
 
-//            cout << "Restart options                       " << endl << endl;
-//            cout << "--sequence-based-restarts=<N>          - Luby et al. sequence using N as number of conflicts." << endl;
-//            cout << "--geometric-restarts=<N>               - Geometric restarts." << endl;
-//            cout << "--minisat-restarts=<N>                 - Minisat restarts." << endl;
-//            cout << "--disable-restarts                     - Disable restarts." << endl;
-//            cout << separator << endl;
-//            
+            cout << "Restart options                        " << endl << endl;
+            cout << "--glucose-restarts                     - Glucose dynamic restarts with blocking (default, Luby with --heuristic-minisat)" << endl;
+            cout << "--ema-restarts                         - Glucose dynamic restarts on exponential moving averages" << endl;
+            cout << "--stable-unstable-restarts=<N>         - Alternate EMA and Luby restarts, starting with a mode of N conflicts (default 1000)" << endl;
+            cout << "--sequence-based-restarts=<N>          - Luby et al. sequence using N as number of conflicts" << endl;
+            cout << "--geometric-restarts=<N>               - Geometric restarts" << endl;
+            cout << "--minisat-restarts=<N>                 - Minisat restarts: geometric, the first after N conflicts and each 1.5 times longer" << endl;
+            cout << "--disable-restarts                     - Disable restarts" << endl;
+            cout << separator << endl;
+
 //            cout << "Deletion options                       " << endl << endl;            
 //            cout << "--aggressive-deletion                  - Aggressive variant of minisat deletion policy." << endl;
 //            cout << "--restarts-based-deletion              - Restarts-based deletion policy." << endl;
@@ -75,6 +78,25 @@ class Help
 //            cout << "--heuristic-berkmin-cache              - Berkmin-like heuristic with cache for choosing polarity." << endl;
 //            cout << "--heuristic-firstundefined             - Choose always the first undefined literal." << endl;
             cout << "--heuristic-minisat                    - Enable minisat heuristic" << endl;
+            cout << "--heuristic-vmtf                       - Enable variable-move-to-front heuristic" << endl;
+            cout << "--heuristic-switching=<N>              - Alternate VMTF and VSIDS, starting with a phase of N conflicts (default 1000)" << endl;
+            cout << "--colouring-dsatur                     - Colouring heuristic chooses vertices by saturation degree (DSATUR)" << endl;
+            cout << "--colouring-lcv                        - Colouring heuristic tries first the least constraining colour" << endl;
+            cout << "--colouring-symmetry                   - Colouring heuristic tries first the colours up to one past the highest used" << endl;
+            cout << "--colouring-symmetry-clauses           - Colouring heuristic adds symmetry breaking clauses on the colours" << endl;
+            cout << "                                         Only sound if colours are interchangeable in the encoding; ignored with -n 0, -n N > 1 and weak constraints" << endl;
+            cout << "--binpacking-strategy=<ff|bf|wf>       - Bin packing heuristic places items by first, best or worst fit (default ff)" << endl;
+            cout << "--binpacking-bounds                    - Bin packing heuristic prunes partial packings with the Martello-Toth bound" << endl;
+            cout << "--pup-orders=<N>                       - PUP heuristic builds the orders of N starting zones in parallel, tried by increasing width (default 1)" << endl;
+            cout << "--heuristic-seeding                    - Heuristics of --heuristic-combined seed the activities and phases of minisat instead of choosing" << endl;
+            cout << separator << endl;
+
+            cout << "Backtracking options                   " << endl << endl;
+            cout << "--chrono-backtracking=threshold        - Backtrack chronologically if the backjump is longer than threshold levels (default 100)" << endl;
+            cout << separator << endl;
+
+            cout << "Phase options                          " << endl << endl;
+            cout << "--rephase=<N>                          - Choose target phases and rephase every N conflicts, growing arithmetically (default 1000)" << endl;
             cout << separator << endl;
 
             cout << "Model Checker options                  " << endl << endl;
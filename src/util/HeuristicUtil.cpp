@@ -19,48 +19,212 @@
 #include "HeuristicUtil.h"
 #include "Assert.h"
 
+const unsigned int TermTable::NONE;
+
 /*
- * parse term of an unary atoms
- * 		( zones, sensors and partner units )
- *
- * 	@param atom 	the atom
- * 	@param name		the term
+ * the characters of a term that are not spaces outside quoted strings: advances
+ * i to the next one and returns false at the end of the term
  */
-void
-HeuristicUtil::getName(
-	string atom,
-	string *name )
+static inline bool
+nextCharacter(
+	StringView term,
+	unsigned int& i,
+	bool& quoted,
+	bool& escaped )
+{
+	for( ; i < term.size(); i++ )
+	{
+		char c = term[ i ];
+		if( escaped )
+			escaped = false;
+		else if( quoted && c == '\\' )
+			escaped = true;
+		else if( c == '"' )
+			quoted = !quoted;
+		else if( !quoted && c == ' ' )
+			continue;
+		return true;
+	}
+	return false;
+}
+
+bool
+TermTokenizer::nextArgument(
+	StringView& argument )
+{
+	if( done )
+		return false;
+
+	unsigned int begin = position;
+	unsigned int depth = 0;
+	bool quoted = false;
+	for( ; position < term.size(); position++ )
+	{
+		char c = term[ position ];
+		if( quoted )
+		{
+			if( c == '\\' )
+				position++;
+			else if( c == '"' )
+				quoted = false;
+			continue;
+		}
+
+		if( c == '"' )
+			quoted = true;
+		else if( c == '(' )
+			depth++;
+		else if( c == ')' && depth > 0 )
+			depth--;
+		else if( depth == 0 && ( c == ',' || c == ')' ) )
+		{
+			unsigned int end = position++;
+			while( begin < end && term[ begin ] == ' ' )
+				begin++;
+			while( end > begin && term[ end - 1 ] == ' ' )
+				end--;
+
+			if( c == ')' )
+			{
+				done = true;
+				for( unsigned int i = position; i < term.size(); i++ )
+					if( term[ i ] != ' ' )
+						malformed = true;
+
+				// no arguments between the parentheses
+				if( begin == end && arity == 0 )
+					return false;
+			}
+
+			if( begin == end )
+				malformed = true;
+			if( malformed )
+				return false;
+
+			argument = term.substr( begin, end - begin );
+			arity++;
+			return true;
+		}
+	}
+
+	done = true;
+	malformed = true;
+	return false;
+}
+
+unsigned int
+TermTable::intern(
+	StringView term )
 {
-	unsigned int start = atom.find_first_of( "(" );
-	unsigned int end = atom.find_last_of( ")" );
+	unsigned int hashValue = hash( term );
+	unsigned int slot = findSlot( term, hashValue );
+	if( slots[ slot ] != NONE )
+		return slots[ slot ];
 
-	assert_msg( start != string::npos && end != string::npos && start < end, "Error while processing " + atom );
+	string name;
+	bool quoted = false;
+	bool escaped = false;
+	for( unsigned int i = 0; nextCharacter( term, i, quoted, escaped ); i++ )
+		name += term[ i ];
 
-	*name = atom.substr( start + 1, end - start - 1 );
+	unsigned int id = names.size();
+	names.push_back( name );
+	hashes.push_back( hashValue );
+	slots[ slot ] = id;
+
+	if( 2 * names.size() > slots.size() )
+		grow();
+	return id;
+}
+
+unsigned int
+TermTable::find(
+	StringView term ) const
+{
+	return slots[ findSlot( term, hash( term ) ) ];
+}
+
+unsigned int
+TermTable::findSlot(
+	StringView term,
+	unsigned int hashValue ) const
+{
+	unsigned int mask = slots.size() - 1;
+	unsigned int slot = hashValue & mask;
+	while( slots[ slot ] != NONE && ( hashes[ slots[ slot ] ] != hashValue || !equals( term, names[ slots[ slot ] ] ) ) )
+		slot = ( slot + 1 ) & mask;
+	return slot;
+}
+
+void
+TermTable::grow()
+{
+	slots.assign( 2 * slots.size(), NONE );
+	unsigned int mask = slots.size() - 1;
+	for( unsigned int id = 0; id < names.size(); id++ )
+	{
+		unsigned int slot = hashes[ id ] & mask;
+		while( slots[ slot ] != NONE )
+			slot = ( slot + 1 ) & mask;
+		slots[ slot ] = id;
+	}
 }
 
 /*
- * read terms of a binary atom
- * 		( unit2zone or unit2sensor )
- *
- * 	@param atom 	the atom
- * 	@param name1	the first term
- * 	@param name2 	the second term
+ * FNV-1a over the characters that are not spaces outside quoted strings
  */
-void
-HeuristicUtil::getName(
-	string atom,
-	string *name1,
-	string *name2 )
+unsigned int
+TermTable::hash(
+	StringView term )
+{
+	unsigned int value = 2166136261u;
+	bool quoted = false;
+	bool escaped = false;
+	for( unsigned int i = 0; nextCharacter( term, i, quoted, escaped ); i++ )
+	{
+		value ^= static_cast< unsigned char >( term[ i ] );
+		value *= 16777619u;
+	}
+	return value;
+}
+
+bool
+TermTable::equals(
+	StringView term,
+	const string& name )
+{
+	bool quoted = false;
+	bool escaped = false;
+	unsigned int j = 0;
+	for( unsigned int i = 0; nextCharacter( term, i, quoted, escaped ); i++ )
+	{
+		if( j == name.size() || name[ j++ ] != term[ i ] )
+			return false;
+	}
+	return j == name.size();
+}
+
+bool
+HeuristicUtil::getNumber(
+	StringView term,
+	int& number )
 {
-	unsigned int start = atom.find_first_of( "(" );
-	unsigned int middle = atom.find_first_of( "," );
-	unsigned int end = atom.find_last_of( ")" );
+	unsigned int i = term.size() > 0 && term[ 0 ] == '-' ? 1 : 0;
+	if( i == term.size() )
+		return false;
 
-	assert_msg( start != string::npos && end != string::npos && start < end, "Error while processing " + atom );
+	long long value = 0;
+	for( ; i < term.size(); i++ )
+	{
+		if( term[ i ] < '0' || term[ i ] > '9' )
+			return false;
+		value = 10 * value + ( term[ i ] - '0' );
+		if( value > INT_MAX )
+			return false;
+	}
 
-	*name1 = atom.substr( start + 1, middle - start - 1 );
-	*name2 = atom.substr( middle + 1, end - middle - 1 );
+	number = term[ 0 ] == '-' ? -value : value;
+	return true;
 }
 
 char
@@ -20,16 +20,125 @@
 #define HEURISTICUTIL_H
 
 #include <cassert>
+#include <climits>
 #include <iostream>
 #include <string>
+#include <vector>
+#include "StringView.h"
 using namespace std;
 
+/*
+ * Splits an ASP term, such as the name of an atom, into its functor and its
+ * top level arguments without copying: the arguments are views into the term.
+ * Nested function terms, tuples and quoted strings (with escapes) are kept
+ * whole; spaces around the functor and the arguments are skipped.
+ */
+class TermTokenizer
+{
+    public:
+		inline TermTokenizer( StringView term );
+
+		/**
+		 * The functor, or the whole term if it has no arguments (empty for tuples).
+		 */
+		inline StringView getFunctor() const { return functor; }
+
+		/**
+		 * Reads the next top level argument; false after the last one, or if
+		 * the term is malformed.
+		 */
+		bool nextArgument( StringView& argument );
+
+		inline bool isMalformed() const { return malformed; }
+
+		/**
+		 * The number of arguments read so far.
+		 */
+		inline unsigned int getArity() const { return arity; }
+
+    private:
+		StringView term;
+		StringView functor;
+		unsigned int position;
+		unsigned int arity;
+		bool done;
+		bool malformed;
+};
+
+/*
+ * Interns terms: equal terms, up to spaces outside quoted strings, get the same
+ * id. Lookups hash the view directly, nothing is allocated for known terms.
+ */
+class TermTable
+{
+    public:
+		static const unsigned int NONE = ~0u;
+
+		inline TermTable() : slots( 16, NONE ) {}
+
+		unsigned int intern( StringView term );
+
+		/**
+		 * The id of the term (NONE if it has not been interned).
+		 */
+		unsigned int find( StringView term ) const;
+
+		inline unsigned int size() const { return names.size(); }
+		inline const string& getName( unsigned int id ) const { assert( id < names.size() ); return names[ id ]; }
+
+    private:
+		unsigned int findSlot( StringView term, unsigned int hashValue ) const;
+		void grow();
+		static unsigned int hash( StringView term );
+		static bool equals( StringView term, const string& name );
+
+		vector< string > names;
+		vector< unsigned int > hashes;
+		// open addressing, linear probing: ids of the terms, NONE for free slots
+		vector< unsigned int > slots;
+};
+
 class HeuristicUtil
 {
     public:
-		static void getName( string atom, string *name );
-		static void getName( string atom, string *name1, string *name2 );
+		/**
+		 * Reads an integer term (an optional minus followed by digits); false
+		 * for any other term.
+		 */
+		static bool getNumber( StringView term, int& number );
+
 		static char tolower( char in );
 };
 
+TermTokenizer::TermTokenizer(
+	StringView t ) : term( t ), position( 0 ), arity( 0 ), done( false ), malformed( false )
+{
+	unsigned int begin = 0;
+	while( begin < term.size() && term[ begin ] == ' ' )
+		begin++;
+
+	// the functor ends at the first parenthesis, unless it is a string or a number
+	unsigned int end = begin;
+	if( end < term.size() && term[ end ] != '"' )
+	{
+		while( end < term.size() && term[ end ] != '(' )
+			end++;
+	}
+
+	position = end;
+	if( position < term.size() && term[ position ] == '(' )
+	{
+		position++;
+	}
+	else
+	{
+		done = true;
+		end = term.size();
+	}
+
+	while( end > begin && term[ end - 1 ] == ' ' )
+		end--;
+	functor = term.substr( begin, end - begin );
+}
+
 #endif
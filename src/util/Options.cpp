@@ -68,12 +68,25 @@ namespace wasp
 #define OPTIONID_colouringheuristic ( 'z' + 35 )
 #define OPTIONID_binpackingheuristic ( 'z' + 36 )
 #define OPTIONID_combinedheuristic ( 'z' + 37 )
+#define OPTIONID_vmtfheuristic ( 'z' + 38 )
+#define OPTIONID_switchingheuristic ( 'z' + 39 )
+#define OPTIONID_colouring_dsatur ( 'z' + 40 )
+#define OPTIONID_colouring_lcv ( 'z' + 41 )
+#define OPTIONID_colouring_symmetry ( 'z' + 42 )
+#define OPTIONID_colouring_symmetry_clauses ( 'z' + 43 )
+#define OPTIONID_binpacking_strategy ( 'z' + 44 )
+#define OPTIONID_binpacking_bounds ( 'z' + 45 )
+#define OPTIONID_pup_orders ( 'z' + 46 )
+#define OPTIONID_heuristic_seeding ( 'z' + 47 )
 
 /* RESTART OPTIONS */
 #define OPTIONID_geometric_restarts ( 'z' + 50 )
 #define OPTIONID_sequence_based_restarts ( 'z' + 51 )
 #define OPTIONID_minisat_restarts ( 'z' + 52 )
 #define OPTIONID_disable_restarts ( 'z' + 53 )
+#define OPTIONID_glucose_restarts ( 'z' + 54 )
+#define OPTIONID_ema_restarts ( 'z' + 55 )
+#define OPTIONID_stable_unstable_restarts ( 'z' + 56 )
 
 /* DELETION OPTIONS */
 #define OPTIONID_aggressive_deletion ( 'z' + 70 )
@@ -81,6 +94,12 @@ namespace wasp
 #define OPTIONID_minisat_deletion ( 'z' + 72 )
 #define OPTIONID_glucose_deletion ( 'z' + 73 )
 
+/* BACKTRACKING OPTIONS */
+#define OPTIONID_chrono_backtracking ( 'z' + 80 )
+
+/* PHASE OPTIONS */
+#define OPTIONID_rephase ( 'z' + 85 )
+
 /* INPUT OPTIONS */
 #define OPTIONID_dimacs ( 'z' + 90 )
 
@@ -128,7 +147,7 @@ bool Options::printProgram = false;
 bool Options::printDimacs = false;
 bool Options::printLastModelOnly = false;
 
-RESTARTS_POLICY Options::restartsPolicy = SEQUENCE_BASED_RESTARTS_POLICY;
+RESTARTS_POLICY Options::restartsPolicy = GLUCOSE_RESTARTS_POLICY;
 
 //unsigned int Options::restartsThreshold = 32;
 //unsigned int Options::restartsThreshold = 100000;
@@ -140,6 +159,28 @@ unsigned int Options::maxModels = 1;
 
 unsigned int Options::deletionThreshold = 8;
 
+unsigned int Options::chronoBacktrackingThreshold = UINT_MAX;
+
+unsigned int Options::switchingHeuristicPhase = 1000;
+
+unsigned int Options::rephaseInterval = 0;
+
+bool Options::colouringDsatur = false;
+
+bool Options::colouringLcv = false;
+
+bool Options::colouringSymmetry = false;
+
+bool Options::colouringSymmetryClauses = false;
+
+unsigned int Options::binpackingStrategy = BINPACKING_FIRST_FIT;
+
+bool Options::binpackingBounds = false;
+
+unsigned int Options::pupOrders = 1;
+
+bool Options::heuristicSeeding = false;
+
 unsigned int Options::maxCost = MAXUNSIGNEDINT;
 
 bool Options::exchangeClauses = false;
@@ -214,12 +255,25 @@ Options::parse(
 				{ "heuristic-colouring", no_argument, NULL, OPTIONID_colouringheuristic },
 				{ "heuristic-binpacking", no_argument, NULL, OPTIONID_binpackingheuristic },
 				{ "heuristic-combined", required_argument, NULL, OPTIONID_combinedheuristic },
+                { "heuristic-vmtf", no_argument, NULL, OPTIONID_vmtfheuristic },
+                { "heuristic-switching", optional_argument, NULL, OPTIONID_switchingheuristic },
+                { "colouring-dsatur", no_argument, NULL, OPTIONID_colouring_dsatur },
+                { "colouring-lcv", no_argument, NULL, OPTIONID_colouring_lcv },
+                { "colouring-symmetry", no_argument, NULL, OPTIONID_colouring_symmetry },
+                { "colouring-symmetry-clauses", no_argument, NULL, OPTIONID_colouring_symmetry_clauses },
+                { "binpacking-strategy", required_argument, NULL, OPTIONID_binpacking_strategy },
+                { "binpacking-bounds", no_argument, NULL, OPTIONID_binpacking_bounds },
+                { "pup-orders", required_argument, NULL, OPTIONID_pup_orders },
+                { "heuristic-seeding", no_argument, NULL, OPTIONID_heuristic_seeding },
                 
                 /* RESTART OPTIONS */                
-//                { "geometric-restarts", optional_argument, NULL, OPTIONID_geometric_restarts },
-//                { "minisat-restarts", optional_argument, NULL, OPTIONID_minisat_restarts },
-//                { "disable-restarts", no_argument, NULL, OPTIONID_disable_restarts },
-//                { "sequence-based-restarts", optional_argument, NULL, OPTIONID_sequence_based_restarts },
+                { "geometric-restarts", optional_argument, NULL, OPTIONID_geometric_restarts },
+                { "minisat-restarts", optional_argument, NULL, OPTIONID_minisat_restarts },
+                { "disable-restarts", no_argument, NULL, OPTIONID_disable_restarts },
+                { "sequence-based-restarts", optional_argument, NULL, OPTIONID_sequence_based_restarts },
+                { "glucose-restarts", no_argument, NULL, OPTIONID_glucose_restarts },
+                { "ema-restarts", no_argument, NULL, OPTIONID_ema_restarts },
+                { "stable-unstable-restarts", optional_argument, NULL, OPTIONID_stable_unstable_restarts },
                 
                 /* DELETION OPTIONS */
 //                { "aggressive-deletion", no_argument, NULL, OPTIONID_aggressive_deletion },
@@ -227,6 +281,12 @@ Options::parse(
 //                { "minisat-deletion", no_argument, NULL, OPTIONID_minisat_deletion },
 //                { "glucose-deletion", optional_argument, NULL, OPTIONID_glucose_deletion },
                 
+                /* BACKTRACKING OPTIONS */
+                { "chrono-backtracking", optional_argument, NULL, OPTIONID_chrono_backtracking },
+                
+                /* PHASE OPTIONS */
+                { "rephase", optional_argument, NULL, OPTIONID_rephase },
+                
                 /* INPUT OPTIONS */
                 { "dimacs", no_argument, NULL, OPTIONID_dimacs },                
                 
@@ -391,6 +451,61 @@ Options::parse(
             	combined_heuristic_option = optarg;
             	break;
 
+            case OPTIONID_vmtfheuristic:
+                decisionPolicy = HEURISTIC_VMTF;
+                break;
+
+            case OPTIONID_switchingheuristic:
+                decisionPolicy = HEURISTIC_SWITCHING;
+                if( optarg )
+                {
+                    switchingHeuristicPhase = atoi( optarg );
+                    if( switchingHeuristicPhase == 0 )
+                        ErrorMessage::errorGeneric( "Inserted invalid phase length for the switching heuristic." );
+                }
+                break;
+
+            case OPTIONID_colouring_dsatur:
+                colouringDsatur = true;
+                break;
+
+            case OPTIONID_colouring_lcv:
+                colouringLcv = true;
+                break;
+
+            case OPTIONID_colouring_symmetry:
+                colouringSymmetry = true;
+                break;
+
+            case OPTIONID_colouring_symmetry_clauses:
+                colouringSymmetryClauses = true;
+                break;
+
+            case OPTIONID_binpacking_strategy:
+                if( !strcmp( optarg, "ff" ) )
+                    binpackingStrategy = BINPACKING_FIRST_FIT;
+                else if( !strcmp( optarg, "bf" ) )
+                    binpackingStrategy = BINPACKING_BEST_FIT;
+                else if( !strcmp( optarg, "wf" ) )
+                    binpackingStrategy = BINPACKING_WORST_FIT;
+                else
+                    ErrorMessage::errorGeneric( "Inserted invalid strategy for the bin packing heuristic." );
+                break;
+
+            case OPTIONID_binpacking_bounds:
+                binpackingBounds = true;
+                break;
+
+            case OPTIONID_pup_orders:
+                pupOrders = atoi( optarg );
+                if( pupOrders == 0 )
+                    pupOrders = 1;
+                break;
+
+            case OPTIONID_heuristic_seeding:
+                heuristicSeeding = true;
+                break;
+
             case OPTIONID_sequence_based_restarts:
                 restartsPolicy = SEQUENCE_BASED_RESTARTS_POLICY;
                 if( optarg )
@@ -424,6 +539,25 @@ Options::parse(
             case OPTIONID_disable_restarts:
                 restartsPolicy = NO_RESTARTS_POLICY;
                 break;
+
+            case OPTIONID_glucose_restarts:
+                restartsPolicy = GLUCOSE_RESTARTS_POLICY;
+                break;
+
+            case OPTIONID_ema_restarts:
+                restartsPolicy = EMA_RESTARTS_POLICY;
+                break;
+
+            case OPTIONID_stable_unstable_restarts:
+                restartsPolicy = STABLE_UNSTABLE_RESTARTS_POLICY;
+                restartsThreshold = 1000;
+                if( optarg )
+                {
+                    restartsThreshold = atoi( optarg );
+                    if( restartsThreshold < 100 )
+                        restartsThreshold = 100;
+                }
+                break;
                 
             case OPTIONID_aggressive_deletion:
                 deletionPolicy = AGGRESSIVE_DELETION_POLICY;
@@ -447,6 +581,18 @@ Options::parse(
                 }
                 break;
 
+            case OPTIONID_chrono_backtracking:
+                chronoBacktrackingThreshold = 100;
+                if( optarg )
+                    chronoBacktrackingThreshold = atoi( optarg );
+                break;
+
+            case OPTIONID_rephase:
+                rephaseInterval = 1000;
+                if( optarg )
+                    rephaseInterval = atoi( optarg );
+                break;
+
             case OPTIONID_dimacs:
                 outputPolicy = DIMACS_OUTPUT;
                 break; 
@@ -48,6 +48,74 @@ namespace wasp
             static bool backwardPartialChecks;
             static bool bumpActivityAfterPartialCheck;
             
+            /**
+             * Backjumps longer than this number of levels are replaced by
+             * chronological backtracking. UINT_MAX disables it.
+             */
+            static unsigned int chronoBacktrackingThreshold;
+            
+            /**
+             * Number of conflicts of the first phase of the heuristic
+             * switching between VMTF and VSIDS.
+             */
+            static unsigned int switchingHeuristicPhase;
+            
+            /**
+             * Number of conflicts between the first two rephases; the following
+             * intervals grow arithmetically. 0 disables target phases and rephasing.
+             */
+            static unsigned int rephaseInterval;
+            
+            /**
+             * The colouring heuristic chooses vertices by saturation degree (DSATUR)
+             * instead of following the static degree order.
+             */
+            static bool colouringDsatur;
+            
+            /**
+             * The colouring heuristic tries first the least constraining colour.
+             */
+            static bool colouringLcv;
+            
+            /**
+             * The colouring heuristic tries first the colours up to one past the
+             * highest colour in use, since the unused colours are interchangeable.
+             */
+            static bool colouringSymmetry;
+            
+            /**
+             * The colouring heuristic adds clauses breaking the symmetry of the
+             * colours (answer sets that differ only by a permutation of the colours
+             * are not computed). Not applied if maxModels is not 1.
+             */
+            static bool colouringSymmetryClauses;
+            
+            static unsigned int maxModels;
+            
+            /**
+             * Placement strategy of the bin packing heuristic: first fit, best fit
+             * or worst fit, on the items by decreasing size.
+             */
+            static unsigned int binpackingStrategy;
+            
+            /**
+             * The bin packing heuristic checks the Martello-Toth lower bound on the
+             * partial packing and backtracks with a clause when it is exceeded.
+             */
+            static bool binpackingBounds;
+            
+            /**
+             * Number of starting zones whose orders the PUP heuristic builds in
+             * parallel; the orders are tried by increasing width.
+             */
+            static unsigned int pupOrders;
+            
+            /**
+             * The domain heuristics of the combined heuristic only seed the
+             * activities and the phases of minisat, which makes all the choices.
+             */
+            static bool heuristicSeeding;
+            
             static unsigned int queryAlgorithm;
             static unsigned int queryVerbosity;
             static bool computeFirstModel;
@@ -71,8 +139,6 @@ namespace wasp
 
             static unsigned int decisionThreshold;
             
-            static unsigned int maxModels;
-
             static OUTPUT_POLICY outputPolicy;
 
             static bool printProgram;
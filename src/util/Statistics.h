@@ -39,14 +39,14 @@ class Solver;
         public:
             inline Statistics() :
             separator( "\n---------------------------\n" ),
-            numberOfRestarts( 0 ), numberOfChoices( 0 ),
+            numberOfRestarts( 0 ), numberOfChronologicalBacktracks( 0 ), numberOfRephases( 0 ), numberOfChoices( 0 ),
             numberOfLearnedClauses( 0 ), numberOfLearnedUnaryClauses( 0 ),
             numberOfLearnedBinaryClauses( 0 ), numberOfLearnedTernaryClauses( 0 ),
             sumOfSizeLearnedClauses( 0 ), minLearnedSize( MAXUNSIGNEDINT ), maxLearnedSize( 0 ),
             numberOfBinaryClauses( 0 ), numberOfTernaryClauses( 0 ), numberOfClauses( 0 ),          
             numberOfDeletion( 0 ), numberOfDeletionInvokation( 0 ),
             minDeletion( MAXUNSIGNEDINT ), maxDeletion( 0 ), shrink( 0 ),
-            shrinkedClauses( 0 ), shrinkedLiterals( 0 ),
+            shrinkedClauses( 0 ), shrinkedLiterals( 0 ), literalsRemovedWithRecursion( 0 ),
             max_literals( 0 ), tot_literals( 0 ), numberOfLearnedClausesFromPropagators( 0 ),
             numberOfLearnedUnaryClausesFromPropagators( 0 ),numberOfLearnedBinaryClausesFromPropagators( 0 ),
             numberOfLearnedTernaryClausesFromPropagators( 0 ), sumOfSizeLearnedClausesFromPropagators( 0 ),
@@ -72,6 +72,16 @@ class Solver;
             {
                 numberOfRestarts++;
             }
+            
+            inline void onChronologicalBacktracking()
+            {
+                numberOfChronologicalBacktracks++;
+            }
+            
+            inline void onRephase()
+            {
+                numberOfRephases++;
+            }
 
             inline void onChoice()
             {
@@ -133,6 +143,8 @@ class Solver;
                     shrinkedLiterals += shrink;
                 }
             }
+            
+            inline void onRemovedLiteral( bool neededRecursion ) { if( neededRecursion ) literalsRemovedWithRecursion++; }
 
             inline void onDeletion( unsigned int /*numberOfLearnedClauses*/, unsigned int del )
             {
@@ -330,6 +342,8 @@ class Solver;
             string separator;
 
             unsigned int numberOfRestarts;
+            unsigned int numberOfChronologicalBacktracks;
+            unsigned int numberOfRephases;
             unsigned int numberOfChoices;
             
             unsigned int numberOfLearnedClauses;
@@ -352,6 +366,7 @@ class Solver;
             uint64_t shrink;
             uint64_t shrinkedClauses;
             uint64_t shrinkedLiterals;
+            uint64_t literalsRemovedWithRecursion;
             
             uint64_t max_literals; 
             uint64_t tot_literals;
@@ -442,8 +457,11 @@ class Solver;
                 cerr << "Solver" << endl << endl;
                 cerr << "Number of choices              : " << numberOfChoices << endl;
                 cerr << "Number of restarts             : " << numberOfRestarts << endl;
+                cerr << "Chronological backtracks       : " << numberOfChronologicalBacktracks << endl;
+                cerr << "Number of rephases             : " << numberOfRephases << endl;
                 cerr << "Shrinked clauses               : " << shrinkedClauses << " (" << ( ( double ) shrinkedClauses * 100 / ( double ) numberOfLearnedClauses ) << "%)" << endl;
                 cerr << "Shrinked literals              : " << shrinkedLiterals << " (" << ( ( double ) shrinkedLiterals * 100 / ( double ) sumOfSizeLearnedClauses ) << "%)" << endl;
+                cerr << "Removed with recursion         : " << literalsRemovedWithRecursion << " (" << ( ( double ) literalsRemovedWithRecursion * 100 / ( double ) shrinkedLiterals ) << "% of shrinked literals)" << endl;
                 cerr << "Conflict literals              : " << tot_literals <<  " (deleted " << ( ( max_literals - tot_literals ) * 100 / ( double ) max_literals ) << "%)" << endl; 
             }
 
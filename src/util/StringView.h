@@ -0,0 +1,98 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef STRINGVIEW_H
+#define STRINGVIEW_H
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+using namespace std;
+
+/*
+ * A read-only range of characters owned by someone else (std::string_view is
+ * not available in C++11). A view is valid as long as its owner is not
+ * modified.
+ */
+class StringView
+{
+    public:
+        static const unsigned int npos = ~0u;
+
+        inline StringView() : begin( NULL ), length( 0 ) {}
+        inline StringView( const char* b, unsigned int l ) : begin( b ), length( l ) {}
+        inline StringView( const char* s ) : begin( s ), length( strlen( s ) ) {}
+        inline StringView( const string& s ) : begin( s.data() ), length( s.size() ) {}
+
+        inline const char* data() const { return begin; }
+        inline unsigned int size() const { return length; }
+        inline bool empty() const { return length == 0; }
+        inline char operator[]( unsigned int i ) const { assert( i < length ); return begin[ i ]; }
+
+        inline string str() const { return string( begin, length ); }
+
+        /**
+         * The characters from position pos, at most n of them.
+         */
+        inline StringView substr( unsigned int pos, unsigned int n = npos ) const;
+
+        inline unsigned int find( char c, unsigned int from = 0 ) const;
+        inline unsigned int rfind( char c ) const;
+
+        inline bool operator==( const StringView& other ) const { return length == other.length && memcmp( begin, other.begin, length ) == 0; }
+        inline bool operator!=( const StringView& other ) const { return !( *this == other ); }
+
+    private:
+        const char* begin;
+        unsigned int length;
+};
+
+StringView
+StringView::substr(
+    unsigned int pos,
+    unsigned int n ) const
+{
+    assert( pos <= length );
+    return StringView( begin + pos, n < length - pos ? n : length - pos );
+}
+
+unsigned int
+StringView::find(
+    char c,
+    unsigned int from ) const
+{
+    for( unsigned int i = from; i < length; i++ )
+        if( begin[ i ] == c )
+            return i;
+    return npos;
+}
+
+unsigned int
+StringView::rfind(
+    char c ) const
+{
+    for( unsigned int i = length; i > 0; i-- )
+        if( begin[ i - 1 ] == c )
+            return i - 1;
+    return npos;
+}
+
+inline ostream& operator<<( ostream& out, const StringView& s ) { return out.write( s.data(), s.size() ); }
+
+#endif
@@ -18,8 +18,21 @@
 
 #include "VariableNames.h"
 #include "Assert.h"
-vector< string > VariableNames::variables;
-bool VariableNames::toBePrinted = false;
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+
+string VariableNames::pool;
+vector< VariableNames::Name > VariableNames::variables;
+TermTable VariableNames::predicates;
+TermTable VariableNames::arguments;
+vector< unsigned int > VariableNames::tuples;
+
+#ifdef TRACE_ON
+// names given to hidden variables while tracing; the nodes of the map do not move
+static unordered_map< Var, string > traceNames;
+#endif
 
 bool
 VariableNames::isHidden(
@@ -28,10 +41,10 @@ VariableNames::isHidden(
     //assert_msg( v < variables.size(), "Var " << v << " is out of index: " << variables.size() );
     if( v >= variables.size() )
         return true;
-    return variables[ v ] == "";
+    return variables[ v ].length == 0;
 }
 
-const string&
+StringView
 VariableNames::getName(
     Var v )
 {
@@ -40,38 +53,79 @@ VariableNames::getName(
     {
         stringstream s;
         s << v;
-        variables[ v ] = s.str();
+        return traceNames[ v ] = s.str();
     }
     #endif
     assert( !isHidden( v ) );
-    return variables[ v ];
+    return getName( variables[ v ] );
 }
 
 void
 VariableNames::setName(
     Var v,
-    string name )
+    const char* name )
 {
     assert_msg( v < variables.size(), "Access element " << v << " in a vector of size " << variables.size() << "." );
-    variables[ v ] = name;
+    Name& n = variables[ v ];
+    n.begin = pool.size();
+    n.length = strlen( name );
+    n.arguments = UNPARSED;
+    pool.append( name, n.length );
+
+    StringView functor = TermTokenizer( getName( n ) ).getFunctor();
+    n.predicate = functor.empty() ? NONE : predicates.intern( functor );
 }
 
 void
 VariableNames::addVariable()
 {
-    variables.push_back( "" );
+    variables.push_back( Name() );
 }
 
 void
 VariableNames::setToBePrinted(
     Var v )
 {
-    variables[ v ] = "1";
+    setName( v, "1" );
 }
 
 bool
 VariableNames::hasToBePrinted(
     Var v )
 {
-    return variables[ v ] == "1";
+    return !isHidden( v ) && getName( variables[ v ] ) == StringView( "1" );
+}
+
+const unsigned int*
+VariableNames::getArguments(
+    Var v,
+    unsigned int& arity )
+{
+    assert( !isHidden( v ) );
+    Name& n = variables[ v ];
+    if( n.arguments == UNPARSED )
+    {
+        n.arguments = tuples.size();
+        tuples.push_back( 0 );
+
+        TermTokenizer tokenizer( getName( n ) );
+        StringView argument;
+        while( tokenizer.nextArgument( argument ) )
+            tuples.push_back( arguments.intern( argument ) );
+
+        if( tokenizer.isMalformed() )
+        {
+            tuples.resize( n.arguments );
+            n.arguments = MALFORMED;
+        }
+        else
+        {
+            tuples[ n.arguments ] = tokenizer.getArity();
+        }
+    }
+
+    if( n.arguments == MALFORMED )
+        return NULL;
+    arity = tuples[ n.arguments ];
+    return tuples.data() + n.arguments + 1;
 }
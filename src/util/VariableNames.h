@@ -21,24 +21,73 @@
 
 #include <cassert>
 #include <iostream>
+#include <string>
 #include <vector>
 #include "Constants.h"
+#include "HeuristicUtil.h"
+#include "StringView.h"
 using namespace std;
 
+/*
+ * The names of the atoms, stored one after the other in a single pool. The
+ * predicates are interned when a name is set; the arguments are split and
+ * interned only for the atoms whose arguments are requested, and then cached.
+ * Views returned by getName are invalidated by the next setName.
+ */
 class VariableNames
 {
     public:
+        static const unsigned int NONE = TermTable::NONE;
 
         static bool isHidden( Var v );
-        static const string& getName( Var v );
-        static void setName( Var v, string name );
+        static StringView getName( Var v );
+        static void setName( Var v, const char* name );
         static void setToBePrinted( Var v );
         static bool hasToBePrinted( Var v );
         static void addVariable();
-        
-    private:        
-        static vector< string > variables;
-        static bool toBePrinted;
+
+        /**
+         * The id of the predicate of v (NONE if v is hidden).
+         */
+        static inline unsigned int getPredicate( Var v ) { assert( v < variables.size() ); return variables[ v ].predicate; }
+
+        /**
+         * The id of the predicate with the given name (NONE if no atom has it).
+         */
+        static inline unsigned int findPredicate( StringView name ) { return predicates.find( name ); }
+        static inline const string& getPredicateName( unsigned int id ) { return predicates.getName( id ); }
+
+        /**
+         * The ids of the arguments of v, of which there are arity (NULL if the
+         * name of v is malformed). Equal arguments of any atom have the same id.
+         */
+        static const unsigned int* getArguments( Var v, unsigned int& arity );
+        static inline unsigned int numberOfArguments() { return arguments.size(); }
+        static inline const string& getArgumentName( unsigned int id ) { return arguments.getName( id ); }
+
+    private:
+        struct Name
+        {
+            inline Name() : begin( 0 ), length( 0 ), predicate( NONE ), arguments( UNPARSED ) {}
+
+            size_t begin;
+            unsigned int length;
+            unsigned int predicate;
+            // position of the arity, followed by the argument ids, in tuples
+            unsigned int arguments;
+        };
+
+        static const unsigned int UNPARSED = ~0u;
+        static const unsigned int MALFORMED = ~0u - 1;
+
+        static inline StringView getName( const Name& n ) { return StringView( pool.data() + n.begin, n.length ); }
+
+        static string pool;
+        static vector< Name > variables;
+
+        static TermTable predicates;
+        static TermTable arguments;
+        static vector< unsigned int > tuples;
 };
 
 #endif
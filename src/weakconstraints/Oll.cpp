@@ -120,7 +120,7 @@ Oll::processCoreOll(
     trace_msg( weakconstraints, 2, "Processing core for algorithm OLL" );
     
     bool trivial = false;
-    Clause* clause = new Clause();
+    Clause* clause = Clause::create();
     unsigned int originalSize = solver.numberOfOptimizationLiterals( level() );
     for( unsigned int i = 0; i < originalSize; i++ )
     {
@@ -188,7 +188,7 @@ Oll::processCoreOll(
     trace_msg( weakconstraints, 2, "Processing core for algorithm OLL" );
     
     bool trivial = false;
-    Clause* clause = new Clause();
+    Clause* clause = Clause::create();
     unsigned int originalSize = solver.numberOfOptimizationLiterals( level() );
     for( unsigned int i = 0; i < originalSize; i++ )
     {
@@ -231,7 +231,7 @@ Oll::processCoreOll(
     
     for( int i = newVars.size() - 1; i >= 1; i-- )
     {
-        Clause* c = new Clause();
+        Clause* c = Clause::create();
         c->addLiteral( Literal( newVars[ i ], NEGATIVE ) );
         c->addLiteral( Literal( newVars[ i - 1 ], POSITIVE ) );
         solver.addClauseRuntime( c );        
@@ -77,7 +77,7 @@ Opt::createOptimizationAggregate(
 
     varId = addAuxVariable();
     Var aggrId = addAuxVariable();
-    Clause* c = new Clause( 2 );
+    Clause* c = Clause::create( 2 );
     c->addLiteral( Literal( varId, POSITIVE ) );
     c->addLiteral( Literal( aggrId, NEGATIVE ) );
     solver.addClauseRuntime( c );
@@ -112,7 +112,7 @@ PMRes::addAuxClauses(
         trace_msg( weakconstraints, 3, "Considering literal " << lit );
                 
         Var aux = addAuxVariable();
-        Clause* clause = new Clause();
+        Clause* clause = Clause::create();
         clause->addLiteral( lit );
         clause->addLiteral( Literal( aux, NEGATIVE ) );
         Var relaxVar = relaxClause( clause );
@@ -122,12 +122,12 @@ PMRes::addAuxClauses(
         if( !addClauseToSolver( clause ) )
             return false;
 
-        Clause* auxClause = new Clause();
+        Clause* auxClause = Clause::create();
         auxClause->addLiteral( Literal( aux, NEGATIVE ) );
         for( unsigned int j = i + 1; j < optLiterals.size(); j++ )
         {
             auxClause->addLiteral( optLiterals[ j ].getOppositeLiteral() );
-            Clause* c1 = new Clause( 2 );
+            Clause* c1 = Clause::create( 2 );
             c1->addLiteral( Literal( aux, POSITIVE ) );
             c1->addLiteral( optLiterals[ j ] );
             trace_msg( weakconstraints, 4, "Adding clause " << *c1 );
@@ -171,7 +171,7 @@ PMRes::foundUnsat()
     vector< Literal > optLiterals;
 
     bool trivial = false;
-    Clause* clause = new Clause();
+    Clause* clause = Clause::create();
     trace_msg( weakconstraints, 1, "Computing hard clause " );
     unsigned int originalSize = solver.numberOfOptimizationLiterals( level() );
 
@@ -252,7 +252,7 @@ PMRes::addAuxClausesCompressed(
         assert_msg( solver.isUndefined( lit ), "Lit " << lit << " is " << ( solver.isTrue( lit ) ? "true" : "false" ) );
         trace_msg( weakconstraints, 3, "Considering literal " << lit );
         
-        Clause* clause = new Clause();
+        Clause* clause = Clause::create();
         clause->addLiteral( lit );
         clause->addLiteral( auxLits[ i + 1 ].getOppositeLiteral() );
         Var relaxVar = relaxClause( clause );
@@ -264,12 +264,12 @@ PMRes::addAuxClausesCompressed(
 
         if( i + 2 < optLiterals.size() )
         {
-            Clause* auxClause = new Clause();
+            Clause* auxClause = Clause::create();
             auxClause->addLiteral( auxLits[ i + 1 ].getOppositeLiteral() );
             auxClause->addLiteral( optLiterals[ i + 1 ].getOppositeLiteral() );
             auxClause->addLiteral( auxLits[ i + 2 ] );
                 
-            Clause* c1 = new Clause( 2 );
+            Clause* c1 = Clause::create( 2 );
             c1->addLiteral( auxLits[ i + 1 ] );
             c1->addLiteral( optLiterals[ i + 1 ] );
             trace_msg( weakconstraints, 4, "Adding clause2 " << *c1 );
@@ -279,7 +279,7 @@ PMRes::addAuxClausesCompressed(
                 return false;
             }        
         
-            Clause* c2 = new Clause( 2 );
+            Clause* c2 = Clause::create( 2 );
             c2->addLiteral( auxLits[ i + 1 ] );
             c2->addLiteral( auxLits[ i + 2 ].getOppositeLiteral() );
             trace_msg( weakconstraints, 4, "Adding clause3 " << *c2 );
@@ -0,0 +1,101 @@
+input = """
+1 2 0 0
+1 3 0 0
+1 4 0 0
+1 5 0 0
+1 6 0 0
+1 7 0 0
+1 8 0 0
+1 9 0 0
+3 3 10 11 12 0 0
+1 13 1 0 10
+1 13 1 0 11
+1 13 1 0 12
+1 1 1 1 13
+2 14 3 0 2 10 11 12
+1 1 1 0 14
+3 3 15 16 17 0 0
+1 18 1 0 15
+1 18 1 0 16
+1 18 1 0 17
+1 1 1 1 18
+2 19 3 0 2 15 16 17
+1 1 1 0 19
+3 3 20 21 22 0 0
+1 23 1 0 20
+1 23 1 0 21
+1 23 1 0 22
+1 1 1 1 23
+2 24 3 0 2 20 21 22
+1 1 1 0 24
+3 3 25 26 27 0 0
+1 28 1 0 25
+1 28 1 0 26
+1 28 1 0 27
+1 1 1 1 28
+2 29 3 0 2 25 26 27
+1 1 1 0 29
+3 3 30 31 32 0 0
+1 33 1 0 30
+1 33 1 0 31
+1 33 1 0 32
+1 1 1 1 33
+2 34 3 0 2 30 31 32
+1 1 1 0 34
+3 3 35 36 37 0 0
+1 38 1 0 35
+1 38 1 0 36
+1 38 1 0 37
+1 1 1 1 38
+2 39 3 0 2 35 36 37
+1 1 1 0 39
+5 40 11 6 0 10 15 20 25 30 35 5 5 4 6 7 3
+1 1 1 0 40
+5 41 11 6 0 11 16 21 26 31 36 5 5 4 6 7 3
+1 1 1 0 41
+5 42 11 6 0 12 17 22 27 32 37 5 5 4 6 7 3
+1 1 1 0 42
+0
+2 nrofbins(3)
+3 maxbinsize(10)
+4 size(i1,5)
+5 size(i2,5)
+6 size(i3,4)
+7 size(i4,6)
+8 size(i5,7)
+9 size(i6,3)
+10 vertex_bin(i1,b1)
+11 vertex_bin(i1,b2)
+12 vertex_bin(i1,b3)
+15 vertex_bin(i2,b1)
+16 vertex_bin(i2,b2)
+17 vertex_bin(i2,b3)
+20 vertex_bin(i3,b1)
+21 vertex_bin(i3,b2)
+22 vertex_bin(i3,b3)
+25 vertex_bin(i4,b1)
+26 vertex_bin(i4,b2)
+27 vertex_bin(i4,b3)
+30 vertex_bin(i5,b1)
+31 vertex_bin(i5,b2)
+32 vertex_bin(i5,b3)
+35 vertex_bin(i6,b1)
+36 vertex_bin(i6,b2)
+37 vertex_bin(i6,b3)
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{nrofbins(3), maxbinsize(10), size(i1,5), size(i2,5), size(i3,4), size(i4,6), size(i5,7), size(i6,3), vertex_bin(i5,b3), vertex_bin(i4,b2), vertex_bin(i1,b1), vertex_bin(i2,b1), vertex_bin(i3,b2), vertex_bin(i6,b3)}
+{nrofbins(3), maxbinsize(10), size(i1,5), size(i2,5), size(i3,4), size(i4,6), size(i5,7), size(i6,3), vertex_bin(i5,b2), vertex_bin(i4,b3), vertex_bin(i1,b1), vertex_bin(i2,b1), vertex_bin(i3,b3), vertex_bin(i6,b2)}
+{nrofbins(3), maxbinsize(10), size(i1,5), size(i2,5), size(i3,4), size(i4,6), size(i5,7), size(i6,3), vertex_bin(i5,b1), vertex_bin(i4,b3), vertex_bin(i1,b2), vertex_bin(i2,b2), vertex_bin(i3,b3), vertex_bin(i6,b1)}
+{nrofbins(3), maxbinsize(10), size(i1,5), size(i2,5), size(i3,4), size(i4,6), size(i5,7), size(i6,3), vertex_bin(i5,b3), vertex_bin(i4,b1), vertex_bin(i1,b2), vertex_bin(i2,b2), vertex_bin(i3,b1), vertex_bin(i6,b3)}
+{nrofbins(3), maxbinsize(10), size(i1,5), size(i2,5), size(i3,4), size(i4,6), size(i5,7), size(i6,3), vertex_bin(i5,b2), vertex_bin(i4,b1), vertex_bin(i1,b3), vertex_bin(i2,b3), vertex_bin(i3,b1), vertex_bin(i6,b2)}
+{nrofbins(3), maxbinsize(10), size(i1,5), size(i2,5), size(i3,4), size(i4,6), size(i5,7), size(i6,3), vertex_bin(i5,b1), vertex_bin(i4,b2), vertex_bin(i1,b3), vertex_bin(i2,b3), vertex_bin(i3,b2), vertex_bin(i6,b1)}
+"""
+flags = "-n 0 --heuristic-combined=binpacking --binpacking-strategy=wf --binpacking-bounds"
@@ -0,0 +1,52 @@
+input = """
+1 2 0 0
+1 3 0 0
+1 4 0 0
+1 5 0 0
+1 6 0 0
+3 2 7 8 0 0
+1 9 1 0 7
+1 9 1 0 8
+1 1 1 1 9
+2 10 2 0 2 7 8
+1 1 1 0 10
+3 2 11 12 0 0
+1 13 1 0 11
+1 13 1 0 12
+1 1 1 1 13
+2 14 2 0 2 11 12
+1 1 1 0 14
+3 2 15 16 0 0
+1 17 1 0 15
+1 17 1 0 16
+1 1 1 1 17
+2 18 2 0 2 15 16
+1 1 1 0 18
+5 19 11 3 0 7 11 15 6 6 6
+1 1 1 0 19
+5 20 11 3 0 8 12 16 6 6 6
+1 1 1 0 20
+0
+2 nrofbins(2)
+3 maxbinsize(10)
+4 size(i1,6)
+5 size(i2,6)
+6 size(i3,6)
+7 vertex_bin(i1,b1)
+8 vertex_bin(i1,b2)
+11 vertex_bin(i2,b1)
+12 vertex_bin(i2,b2)
+15 vertex_bin(i3,b1)
+16 vertex_bin(i3,b2)
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+INCOHERENT
+"""
+flags = "-n 0 --heuristic-combined=binpacking --binpacking-strategy=wf --binpacking-bounds"
@@ -0,0 +1,116 @@
+input = """
+1 2 0 0
+1 3 0 0
+1 4 0 0
+1 5 0 0
+1 6 0 0
+1 7 0 0
+1 8 0 0
+1 9 0 0
+1 10 0 0
+1 11 0 0
+1 12 0 0
+1 13 0 0
+1 14 0 0
+3 3 15 16 17 0 0
+1 18 1 0 15
+1 18 1 0 16
+1 18 1 0 17
+1 1 1 1 18
+1 1 2 0 15 16
+1 1 2 0 15 17
+1 1 2 0 16 17
+3 3 19 20 21 0 0
+1 22 1 0 19
+1 22 1 0 20
+1 22 1 0 21
+1 1 1 1 22
+1 1 2 0 19 20
+1 1 2 0 19 21
+1 1 2 0 20 21
+3 3 23 24 25 0 0
+1 26 1 0 23
+1 26 1 0 24
+1 26 1 0 25
+1 1 1 1 26
+1 1 2 0 23 24
+1 1 2 0 23 25
+1 1 2 0 24 25
+3 3 27 28 29 0 0
+1 30 1 0 27
+1 30 1 0 28
+1 30 1 0 29
+1 1 1 1 30
+1 1 2 0 27 28
+1 1 2 0 27 29
+1 1 2 0 28 29
+3 3 31 32 33 0 0
+1 34 1 0 31
+1 34 1 0 32
+1 34 1 0 33
+1 1 1 1 34
+1 1 2 0 31 32
+1 1 2 0 31 33
+1 1 2 0 32 33
+1 1 2 0 15 19
+1 1 2 0 16 20
+1 1 2 0 17 21
+1 1 2 0 19 23
+1 1 2 0 20 24
+1 1 2 0 21 25
+1 1 2 0 15 23
+1 1 2 0 16 24
+1 1 2 0 17 25
+1 1 2 0 23 27
+1 1 2 0 24 28
+1 1 2 0 25 29
+1 1 2 0 27 31
+1 1 2 0 28 32
+1 1 2 0 29 33
+1 1 2 0 31 15
+1 1 2 0 32 16
+1 1 2 0 33 17
+1 1 2 0 19 31
+1 1 2 0 20 32
+1 1 2 0 21 33
+0
+2 nrofcolors(3)
+3 degree(a,3)
+4 degree(b,3)
+5 degree(c,3)
+6 degree(d,2)
+7 degree(e,3)
+8 link(a,b)
+9 link(b,c)
+10 link(a,c)
+11 link(c,d)
+12 link(d,e)
+13 link(e,a)
+14 link(b,e)
+15 chosenColour(a,c0)
+16 chosenColour(a,c1)
+17 chosenColour(a,c2)
+19 chosenColour(b,c0)
+20 chosenColour(b,c1)
+21 chosenColour(b,c2)
+23 chosenColour(c,c0)
+24 chosenColour(c,c1)
+25 chosenColour(c,c2)
+27 chosenColour(d,c0)
+28 chosenColour(d,c1)
+29 chosenColour(d,c2)
+31 chosenColour(e,c0)
+32 chosenColour(e,c1)
+33 chosenColour(e,c2)
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{nrofcolors(3), degree(a,3), degree(b,3), degree(c,3), degree(d,2), degree(e,3), link(a,b), link(b,c), link(a,c), link(c,d), link(d,e), link(e,a), link(b,e), chosenColour(a,c0), chosenColour(b,c1), chosenColour(c,c2), chosenColour(e,c2), chosenColour(d,c1)}
+"""
+flags = "--heuristic-combined=colouring --colouring-symmetry-clauses"
@@ -0,0 +1,98 @@
+input = """
+1 2 0 0
+1 3 0 0
+1 4 0 0
+1 5 0 0
+1 6 0 0
+1 7 0 0
+1 8 0 0
+1 9 0 0
+1 10 0 0
+1 11 0 0
+1 12 0 0
+3 3 13 14 15 0 0
+1 16 1 0 13
+1 16 1 0 14
+1 16 1 0 15
+1 1 1 1 16
+1 1 2 0 13 14
+1 1 2 0 13 15
+1 1 2 0 14 15
+3 3 17 18 19 0 0
+1 20 1 0 17
+1 20 1 0 18
+1 20 1 0 19
+1 1 1 1 20
+1 1 2 0 17 18
+1 1 2 0 17 19
+1 1 2 0 18 19
+3 3 21 22 23 0 0
+1 24 1 0 21
+1 24 1 0 22
+1 24 1 0 23
+1 1 1 1 24
+1 1 2 0 21 22
+1 1 2 0 21 23
+1 1 2 0 22 23
+3 3 25 26 27 0 0
+1 28 1 0 25
+1 28 1 0 26
+1 28 1 0 27
+1 1 1 1 28
+1 1 2 0 25 26
+1 1 2 0 25 27
+1 1 2 0 26 27
+1 1 2 0 13 17
+1 1 2 0 14 18
+1 1 2 0 15 19
+1 1 2 0 17 21
+1 1 2 0 18 22
+1 1 2 0 19 23
+1 1 2 0 13 21
+1 1 2 0 14 22
+1 1 2 0 15 23
+1 1 2 0 13 25
+1 1 2 0 14 26
+1 1 2 0 15 27
+1 1 2 0 17 25
+1 1 2 0 18 26
+1 1 2 0 19 27
+1 1 2 0 21 25
+1 1 2 0 22 26
+1 1 2 0 23 27
+0
+2 nrofcolors(3)
+3 degree(a,3)
+4 degree(b,3)
+5 degree(c,3)
+6 degree(d,3)
+7 link(a,b)
+8 link(b,c)
+9 link(a,c)
+10 link(a,d)
+11 link(b,d)
+12 link(c,d)
+13 chosenColour(a,c0)
+14 chosenColour(a,c1)
+15 chosenColour(a,c2)
+17 chosenColour(b,c0)
+18 chosenColour(b,c1)
+19 chosenColour(b,c2)
+21 chosenColour(c,c0)
+22 chosenColour(c,c1)
+23 chosenColour(c,c2)
+25 chosenColour(d,c0)
+26 chosenColour(d,c1)
+27 chosenColour(d,c2)
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+INCOHERENT
+"""
+flags = "--heuristic-combined=colouring --colouring-symmetry-clauses"
@@ -0,0 +1,70 @@
+input = """
+1 2 0 0
+1 3 0 0
+1 4 0 0
+1 5 0 0
+1 6 0 0
+1 7 0 0
+1 8 0 0
+3 3 9 10 11 0 0
+1 12 1 0 9
+1 12 1 0 10
+1 12 1 0 11
+1 1 1 1 12
+1 1 2 0 9 10
+1 1 2 0 9 11
+1 1 2 0 10 11
+3 3 13 14 15 0 0
+1 16 1 0 13
+1 16 1 0 14
+1 16 1 0 15
+1 1 1 1 16
+1 1 2 0 13 14
+1 1 2 0 13 15
+1 1 2 0 14 15
+3 3 17 18 19 0 0
+1 20 1 0 17
+1 20 1 0 18
+1 20 1 0 19
+1 1 1 1 20
+1 1 2 0 17 18
+1 1 2 0 17 19
+1 1 2 0 18 19
+1 1 2 0 9 13
+1 1 2 0 10 14
+1 1 2 0 11 15
+1 1 2 0 13 17
+1 1 2 0 14 18
+1 1 2 0 15 19
+1 1 2 0 9 17
+1 1 2 0 10 18
+1 1 2 0 11 19
+0
+2 nrofcolors(3)
+3 degree(a,2)
+4 degree(b,2)
+5 degree(c,2)
+6 link(a,b)
+7 link(b,c)
+8 link(a,c)
+9 chosenColour(a,c0)
+10 chosenColour(a,c1)
+11 chosenColour(a,c2)
+13 chosenColour(b,c0)
+14 chosenColour(b,c1)
+15 chosenColour(b,c2)
+17 chosenColour(c,c0)
+18 chosenColour(c,c1)
+19 chosenColour(c,c2)
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{nrofcolors(3), degree(a,2), degree(b,2), degree(c,2), link(a,b), link(b,c), link(a,c), chosenColour(a,c0), chosenColour(b,c1), chosenColour(c,c2)}
+"""
+flags = "--heuristic-combined=colouring --colouring-symmetry-clauses"
@@ -0,0 +1,449 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+/*
+ * Microbenchmark for the memory layout of Variables.
+ *
+ * It replays the accesses performed during search: Variables::assign with a
+ * reason, the walk on the trail of Learning::onConflict (truth value and
+ * implicant of the trail variable, decision levels of the literals in its
+ * reason) and the unroll of the trail. Every assigned variable has
+ * ANTECEDENTS literals in its reason, chosen among the last WINDOW variables
+ * assigned before it, and variables are assigned in random order. The reason
+ * objects are taken from a pool of REASONS entries, since during propagation
+ * the reason has just been read and is already in cache.
+ *
+ * The workload runs on three layouts:
+ *   old        the record per variable used before the split (implicant
+ *              pointer, components, reason for binary clauses, decision
+ *              level and flags in 40 bytes);
+ *   new        the split arrays of Variables (truth values, and decision
+ *              level with the 32-bit reference of the implicant in 8 bytes);
+ *   Variables  the Variables class of the solver, which must time as new.
+ * Times are reported in ns per variable. For old and new the benchmark also
+ * counts the cache lines of 64 bytes that are touched: on average by the
+ * operation on one variable, and in a whole pass over the trail divided by
+ * the number of variables (the footprint that has to come from memory when
+ * the variables do not fit in cache).
+ *
+ * Usage: VariablesLayout [numberOfVariables] [numberOfOperations]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unordered_set>
+#include <vector>
+
+#include "Variables.h"
+
+using namespace std;
+
+// Defined in main.cpp, which is not linked here.
+int EXIT_CODE = 0;
+
+#define ANTECEDENTS 3
+#define WINDOW 256
+#define DECISION_EVERY 32
+#define REASONS 64
+#define CACHE_LINE 64
+
+struct Workload
+{
+    vector< Var > order;
+    vector< Var > antecedents;
+};
+
+/*
+ * the layouts report the memory they touch; NoCounter is used for timing
+ */
+class NoCounter
+{
+    public:
+        inline void touch( const void*, size_t ) {}
+        inline void endOperation() {}
+};
+
+class LineCounter
+{
+    public:
+        inline LineCounter() : operations( 0 ), touchedByOperations( 0 ) {}
+
+        inline void touch( const void* address, size_t size );
+        inline void endOperation();
+        inline void reset() { operations = 0; touchedByOperations = 0; passLines.clear(); }
+
+        inline double linesPerOperation() const { return operations == 0 ? 0 : double( touchedByOperations ) / operations; }
+        inline unsigned int linesInPass() const { return passLines.size(); }
+
+    private:
+        unsigned int operations;
+        uint64_t touchedByOperations;
+        vector< uintptr_t > operationLines;
+        unordered_set< uintptr_t > passLines;
+};
+
+void
+LineCounter::touch(
+    const void* address,
+    size_t size )
+{
+    uintptr_t first = reinterpret_cast< uintptr_t >( address ) / CACHE_LINE;
+    uintptr_t last = ( reinterpret_cast< uintptr_t >( address ) + size - 1 ) / CACHE_LINE;
+    for( uintptr_t line = first; line <= last; line++ )
+    {
+        if( find( operationLines.begin(), operationLines.end(), line ) == operationLines.end() )
+            operationLines.push_back( line );
+        passLines.insert( line );
+    }
+}
+
+void
+LineCounter::endOperation()
+{
+    operations++;
+    touchedByOperations += operationLines.size();
+    operationLines.clear();
+}
+
+/*
+ * the layout of Variables before the split: one record per variable
+ */
+template< class Counter >
+class OldLayout
+{
+    public:
+        inline OldLayout( unsigned int n, Counter& c ) : assigns( n + 1, UNDEFINED ), data( n + 1 ), assignedVariables( n ), assignedVariablesSize( 0 ), counter( c ) {}
+
+        inline void assign( unsigned int level, Literal literal, Reason* implicant, unsigned int );
+        inline Var getAssignedVariable( unsigned int i ) { counter.touch( &assignedVariables[ i ], sizeof( Var ) ); return assignedVariables[ i ]; }
+        inline bool isTrue( Var v ) { counter.touch( &assigns[ v ], sizeof( TruthValue ) ); return assigns[ v ] == TRUE; }
+        inline bool hasImplicant( Var v ) { counter.touch( &data[ v ].implicant, sizeof( Reason* ) ); return data[ v ].implicant != NULL; }
+        inline unsigned int getDecisionLevel( Var v ) { counter.touch( flags( v ), sizeof( unsigned int ) ); return data[ v ].decisionLevel; }
+        inline unsigned int numberOfAssignedLiterals() const { return assignedVariablesSize; }
+        inline void unrollLastVariable();
+        inline void onUnroll() {}
+
+    private:
+        struct Data
+        {
+            Reason* implicant;
+            void* component;
+            void* hcComponent;
+            void* reasonForBinaryClauses;
+
+            unsigned int decisionLevel : 27;
+            unsigned int isAssumptionAND : 1;
+            unsigned int isAssumptionOR : 1;
+            unsigned int frozen : 1;
+            unsigned int signOfEliminatedVariable : 2;
+        };
+
+        // the word of the bit fields, after the four pointers
+        inline const char* flags( Var v ) const { return reinterpret_cast< const char* >( &data[ v ] ) + 4 * sizeof( void* ); }
+
+        vector< TruthValue > assigns;
+        vector< Data > data;
+        vector< Var > assignedVariables;
+        unsigned int assignedVariablesSize;
+        Counter& counter;
+};
+
+template< class Counter >
+void
+OldLayout< Counter >::assign(
+    unsigned int level,
+    Literal literal,
+    Reason* implicant,
+    unsigned int )
+{
+    Var v = literal.getVariable();
+    counter.touch( &assigns[ v ], sizeof( TruthValue ) );
+    assigns[ v ] = literal.isPositive() ? TRUE : FALSE;
+    counter.touch( &assignedVariables[ assignedVariablesSize ], sizeof( Var ) );
+    assignedVariables[ assignedVariablesSize++ ] = v;
+    counter.touch( &data[ v ].implicant, sizeof( Reason* ) );
+    counter.touch( flags( v ), sizeof( unsigned int ) );
+    data[ v ].decisionLevel = level;
+    data[ v ].implicant = implicant;
+}
+
+template< class Counter >
+void
+OldLayout< Counter >::unrollLastVariable()
+{
+    counter.touch( &assignedVariables[ assignedVariablesSize - 1 ], sizeof( Var ) );
+    Var v = assignedVariables[ --assignedVariablesSize ];
+    counter.touch( &assigns[ v ], sizeof( TruthValue ) );
+    assigns[ v ] = UNDEFINED;
+}
+
+/*
+ * the layout of Variables: truth values, and decision level and implicant
+ * reference in one record
+ */
+template< class Counter >
+class NewLayout
+{
+    public:
+        inline NewLayout( unsigned int n, Counter& c ) : assigns( n + 1, UNDEFINED ), states( n + 1 ), assignedVariables( n ), assignedVariablesSize( 0 ), counter( c ) {}
+
+        inline void assign( unsigned int level, Literal literal, Reason*, unsigned int implicant );
+        inline Var getAssignedVariable( unsigned int i ) { counter.touch( &assignedVariables[ i ], sizeof( Var ) ); return assignedVariables[ i ]; }
+        inline bool isTrue( Var v ) { counter.touch( &assigns[ v ], sizeof( TruthValue ) ); return assigns[ v ] == TRUE; }
+        inline bool hasImplicant( Var v ) { counter.touch( &states[ v ], sizeof( VariableState ) ); return states[ v ].implicant != 0; }
+        inline unsigned int getDecisionLevel( Var v ) { counter.touch( &states[ v ], sizeof( VariableState ) ); return states[ v ].decisionLevel; }
+        inline unsigned int numberOfAssignedLiterals() const { return assignedVariablesSize; }
+        inline void unrollLastVariable();
+        inline void onUnroll() {}
+
+    private:
+        vector< TruthValue > assigns;
+        vector< VariableState > states;
+        vector< Var > assignedVariables;
+        unsigned int assignedVariablesSize;
+        Counter& counter;
+};
+
+template< class Counter >
+void
+NewLayout< Counter >::assign(
+    unsigned int level,
+    Literal literal,
+    Reason*,
+    unsigned int implicant )
+{
+    Var v = literal.getVariable();
+    counter.touch( &assigns[ v ], sizeof( TruthValue ) );
+    assigns[ v ] = literal.isPositive() ? TRUE : FALSE;
+    counter.touch( &assignedVariables[ assignedVariablesSize ], sizeof( Var ) );
+    assignedVariables[ assignedVariablesSize++ ] = v;
+    counter.touch( &states[ v ], sizeof( VariableState ) );
+    states[ v ].decisionLevel = level;
+    states[ v ].implicant = implicant;
+}
+
+template< class Counter >
+void
+NewLayout< Counter >::unrollLastVariable()
+{
+    counter.touch( &assignedVariables[ assignedVariablesSize - 1 ], sizeof( Var ) );
+    Var v = assignedVariables[ --assignedVariablesSize ];
+    counter.touch( &assigns[ v ], sizeof( TruthValue ) );
+    assigns[ v ] = UNDEFINED;
+}
+
+/*
+ * the Variables class of the solver, with the interface of the layouts above
+ */
+class SolverLayout
+{
+    public:
+        inline SolverLayout( unsigned int n, NoCounter& ) { for( unsigned int i = 0; i < n; i++ ) variables.push_back(); }
+
+        inline void assign( unsigned int level, Literal literal, Reason* implicant, unsigned int ) { variables.assign( level, literal, implicant ); }
+        inline Var getAssignedVariable( unsigned int i ) { return variables.getAssignedVariable( i ); }
+        inline bool isTrue( Var v ) const { return variables.isTrue( v ); }
+        inline bool hasImplicant( Var v ) const { return variables.hasImplicant( v ); }
+        inline unsigned int getDecisionLevel( Var v ) const { return variables.getDecisionLevel( v ); }
+        inline unsigned int numberOfAssignedLiterals() const { return variables.numberOfAssignedLiterals(); }
+        inline void unrollLastVariable() { variables.unrollLastVariable(); }
+        inline void onUnroll() { variables.onUnroll(); }
+
+    private:
+        Variables variables;
+};
+
+static void
+createWorkload(
+    unsigned int n,
+    Workload& workload )
+{
+    workload.order.clear();
+    for( Var i = 1; i <= n; i++ )
+        workload.order.push_back( i );
+    srand( 17 );
+    for( unsigned int i = workload.order.size() - 1; i > 0; i-- )
+        swap( workload.order[ i ], workload.order[ rand() % ( i + 1 ) ] );
+
+    workload.antecedents.assign( workload.order.size() * ANTECEDENTS, 0 );
+    for( unsigned int i = 1; i < workload.order.size(); i++ )
+        for( unsigned int j = 0; j < ANTECEDENTS; j++ )
+            workload.antecedents[ i * ANTECEDENTS + j ] = workload.order[ i - 1 - rand() % min( i, ( unsigned int ) WINDOW ) ];
+}
+
+template< class Layout, class Counter >
+static void
+assignAll(
+    Layout& layout,
+    Counter& counter,
+    const Workload& workload,
+    Reason** reasons )
+{
+    for( unsigned int i = 0; i < workload.order.size(); i++ )
+    {
+        Var v = workload.order[ i ];
+        unsigned int reason = i % DECISION_EVERY == 0 ? 0 : 1 + i % REASONS;
+        layout.assign( i / DECISION_EVERY, Literal( v, i & 1 ), reasons[ reason ], reason );
+        counter.endOperation();
+    }
+}
+
+template< class Layout, class Counter >
+static unsigned int
+walkTrail(
+    Layout& layout,
+    Counter& counter,
+    const Workload& workload )
+{
+    unsigned int sum = 0;
+    for( unsigned int i = workload.order.size() - 1; i > 0; i-- )
+    {
+        Var v = layout.getAssignedVariable( i );
+        sum += layout.isTrue( v );
+        if( layout.hasImplicant( v ) )
+        {
+            for( unsigned int j = 0; j < ANTECEDENTS; j++ )
+                sum += layout.getDecisionLevel( workload.antecedents[ i * ANTECEDENTS + j ] );
+        }
+        counter.endOperation();
+    }
+    return sum;
+}
+
+template< class Layout, class Counter >
+static void
+unrollAll(
+    Layout& layout,
+    Counter& counter )
+{
+    while( layout.numberOfAssignedLiterals() > 0 )
+    {
+        layout.unrollLastVariable();
+        counter.endOperation();
+    }
+    layout.onUnroll();
+}
+
+/*
+ * ns per variable of assign, conflict step and unroll
+ */
+template< class Layout >
+static unsigned int
+measureTime(
+    const char* name,
+    unsigned int n,
+    unsigned int rounds,
+    const Workload& workload,
+    Reason** reasons )
+{
+    NoCounter counter;
+    Layout layout( n, counter );
+    double assignTime = 0, walkTime = 0, unrollTime = 0;
+    unsigned int sum = 0;
+    for( unsigned int r = 0; r < rounds; r++ )
+    {
+        clock_t start = clock();
+        assignAll( layout, counter, workload, reasons );
+        clock_t assigned = clock();
+        sum += walkTrail( layout, counter, workload );
+        clock_t walked = clock();
+        unrollAll( layout, counter );
+        clock_t unrolled = clock();
+
+        assignTime += double( assigned - start );
+        walkTime += double( walked - assigned );
+        unrollTime += double( unrolled - walked );
+    }
+
+    double scale = 1e9 / CLOCKS_PER_SEC / ( double( rounds ) * n );
+    printf( "%-10s assign: %6.2f ns | conflict step: %6.2f ns | unroll: %6.2f ns\n", name, assignTime * scale, walkTime * scale, unrollTime * scale );
+    return sum;
+}
+
+/*
+ * cache lines per variable touched by the operation and in the whole pass
+ */
+template< template< class > class Layout >
+static unsigned int
+countLines(
+    const char* name,
+    unsigned int n,
+    const Workload& workload,
+    Reason** reasons )
+{
+    LineCounter counter;
+    Layout< LineCounter > layout( n, counter );
+
+    assignAll( layout, counter, workload, reasons );
+    double assignLines = counter.linesPerOperation();
+    double assignPass = double( counter.linesInPass() ) / n;
+    counter.reset();
+
+    unsigned int sum = walkTrail( layout, counter, workload );
+    double walkLines = counter.linesPerOperation();
+    double walkPass = double( counter.linesInPass() ) / n;
+    counter.reset();
+
+    unrollAll( layout, counter );
+    printf( "%-10s assign: %4.2f / %4.2f | conflict step: %4.2f / %4.2f | unroll: %4.2f / %4.2f\n", name,
+        assignLines, assignPass, walkLines, walkPass, counter.linesPerOperation(), double( counter.linesInPass() ) / n );
+    return sum;
+}
+
+int
+main(
+    int argc,
+    char** argv )
+{
+    unsigned int n = argc > 1 ? atoi( argv[ 1 ] ) : 1 << 20;
+    unsigned int operations = argc > 2 ? atoi( argv[ 2 ] ) : 1 << 26;
+    if( n < 2 )
+    {
+        fprintf( stderr, "The number of variables must be at least 2.\n" );
+        return 1;
+    }
+
+    Workload workload;
+    createWorkload( n, workload );
+
+    // reason 0 is no reason (a choice), the others come from a pool
+    Variables pool;
+    for( unsigned int i = 0; i < REASONS; i++ )
+        pool.push_back();
+    Reason* reasons[ REASONS + 1 ];
+    reasons[ 0 ] = NULL;
+    for( unsigned int i = 1; i <= REASONS; i++ )
+        reasons[ i ] = pool.getReasonForBinaryClauses( i );
+
+    unsigned int rounds = max( 1u, operations / n );
+    unsigned int sum = 0;
+    printf( "%u variables, %u rounds, %u antecedents per reason\n", n, rounds, ANTECEDENTS );
+    sum += measureTime< OldLayout< NoCounter > >( "old", n, rounds, workload, reasons );
+    sum += measureTime< NewLayout< NoCounter > >( "new", n, rounds, workload, reasons );
+    sum += measureTime< SolverLayout >( "Variables", n, rounds, workload, reasons );
+
+    printf( "cache lines per variable, touched by the operation / in the whole pass\n" );
+    sum += countLines< OldLayout >( "old", n, workload, reasons );
+    sum += countLines< NewLayout >( "new", n, workload, reasons );
+    if( sum == 0 )
+        printf( "\n" );
+    return 0;
+}